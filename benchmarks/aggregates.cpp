@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include "aggregates.hpp"
+
+using namespace MetaCore;
+
+static void BM_HistoryPush(benchmark::State& state) {
+    History<1024> history;
+    float value = 0;
+    for (auto _ : state)
+        history.push(value += 0.1);
+    benchmark::DoNotOptimize(history.sum());
+}
+BENCHMARK(BM_HistoryPush);
+
+static void BM_HistoryMean(benchmark::State& state) {
+    History<1024> history;
+    for (int i = 0; i < 4800; i++)
+        history.push(i % 17);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(history.mean());
+}
+BENCHMARK(BM_HistoryMean);
+
+static void BM_HistoryWindowMax(benchmark::State& state) {
+    History<1024> history;
+    for (int i = 0; i < 4800; i++)
+        history.push(i % 17);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(history.max(state.range(0)));
+}
+BENCHMARK(BM_HistoryWindowMax)->Arg(4)->Arg(20);
+
+static void BM_WindowPush(benchmark::State& state) {
+    Window window(state.range(0));
+    float value = 0;
+    for (auto _ : state) {
+        window.push(std::fmod(value += 7.3, 100));
+        benchmark::DoNotOptimize(window.max());
+    }
+}
+BENCHMARK(BM_WindowPush)->Arg(20)->Arg(1200);
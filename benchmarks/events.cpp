@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include "dispatch.hpp"
+#include "events.hpp"
+
+using namespace MetaCore;
+
+static void BM_Broadcast(benchmark::State& state) {
+    int calls = 0;
+    std::vector<int> ids;
+    for (int i = 0; i < state.range(0); i++)
+        ids.emplace_back(Events::AddCallback(Events::ScoreChanged, [&calls]() { calls++; }));
+
+    for (auto _ : state)
+        Events::Broadcast(Events::ScoreChanged);
+    benchmark::DoNotOptimize(calls);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    for (auto id : ids)
+        Events::RemoveCallback(id);
+}
+BENCHMARK(BM_Broadcast)->Arg(1)->Arg(8)->Arg(64);
+
+static void BM_BroadcastCustom(benchmark::State& state) {
+    int event = Events::RegisterEvent("benchmarks", 0);
+    int calls = 0;
+    int id = Events::AddCallback(event, [&calls]() { calls++; });
+
+    for (auto _ : state)
+        Events::Broadcast(event);
+    benchmark::DoNotOptimize(calls);
+
+    Events::RemoveCallback(id);
+}
+BENCHMARK(BM_BroadcastCustom);
+
+static void BM_BroadcastByName(benchmark::State& state) {
+    Events::RegisterEvent("benchmarks", 1);
+    int calls = 0;
+    int id = Events::AddCallback("benchmarks", 1, [&calls]() { calls++; });
+
+    for (auto _ : state)
+        Events::Broadcast("benchmarks", 1);
+    benchmark::DoNotOptimize(calls);
+
+    Events::RemoveCallback(id);
+}
+BENCHMARK(BM_BroadcastByName);
+
+struct BenchmarkPayload {
+    static constexpr int Event = Events::NoteCut;
+
+    int saber;
+    float songTime;
+};
+
+static void BM_BroadcastPayload(benchmark::State& state) {
+    float total = 0;
+    int id = Events::AddCallback<BenchmarkPayload>([&total](BenchmarkPayload const& payload) { total += payload.songTime; });
+
+    for (auto _ : state)
+        Events::Broadcast(BenchmarkPayload{0, 1});
+    benchmark::DoNotOptimize(total);
+
+    Events::RemoveCallback(id);
+}
+BENCHMARK(BM_BroadcastPayload);
+
+static void BM_BroadcastAsync(benchmark::State& state) {
+    int calls = 0;
+    int id = Events::AddCallback(Events::HealthChanged, [&calls]() { calls++; });
+
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i++)
+            Events::BroadcastAsync(Events::HealthChanged);
+        Events::RunAsyncBroadcasts();
+    }
+    benchmark::DoNotOptimize(calls);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    Events::RemoveCallback(id);
+}
+BENCHMARK(BM_BroadcastAsync)->Arg(1)->Arg(64);
+
+static void BM_AddRemoveCallback(benchmark::State& state) {
+    for (auto _ : state) {
+        int id = Events::AddCallback(Events::Update, []() {});
+        Events::RemoveCallback(id);
+    }
+}
+BENCHMARK(BM_AddRemoveCallback);
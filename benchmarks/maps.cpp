@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "maps.hpp"
+
+using namespace MetaCore;
+
+static void BM_CacheMapPush(benchmark::State& state) {
+    CacheMap<int, int, 32> map;
+    int i = 0;
+    for (auto _ : state) {
+        map.push(i % state.range(0), i);
+        i++;
+    }
+    benchmark::DoNotOptimize(map.size());
+}
+BENCHMARK(BM_CacheMapPush)->Arg(16)->Arg(256);
+
+static void BM_CacheMapAt(benchmark::State& state) {
+    CacheMap<std::string, int, 32> map;
+    std::vector<std::string> keys;
+    for (int i = 0; i < 32; i++) {
+        keys.emplace_back("custom_level_" + std::to_string(i));
+        map.push(keys.back(), i);
+    }
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(map.at(keys[i++ % keys.size()]));
+}
+BENCHMARK(BM_CacheMapAt);
+
+static void BM_IndexMapPushErase(benchmark::State& state) {
+    IndexMap<int> map;
+    std::vector<int> ids(state.range(0));
+    for (auto _ : state) {
+        for (int i = 0; i < ids.size(); i++)
+            ids[i] = map.push(i);
+        for (auto id : ids)
+            map.erase(id);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IndexMapPushErase)->Arg(16)->Arg(1024);
+
+static void BM_IndexMapAt(benchmark::State& state) {
+    IndexMap<int> map;
+    for (int i = 0; i < state.range(0); i++)
+        map.push(i);
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(map.at(i++ % state.range(0)));
+}
+BENCHMARK(BM_IndexMapAt)->Arg(16)->Arg(1024);
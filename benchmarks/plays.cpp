@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include "fmt/format.h"
+#include "plays.hpp"
+
+using namespace MetaCore;
+
+static constexpr int HistoryPlays = 100000;
+static constexpr int HistoryBeatmaps = 1000;
+static constexpr int64_t Day = 24 * 60 * 60 * 1000;
+
+// a history of 100k plays spread over a year
+static void OpenHistory() {
+    static bool created = false;
+    auto directory = std::filesystem::temp_directory_path() / "metacore-benchmark-plays";
+    if (!created) {
+        std::filesystem::remove_all(directory);
+        Plays::Open(directory.string());
+        for (int i = 0; i < HistoryPlays; i++) {
+            Plays::Add(
+                fmt::format("custom_level_{}Standard{}", i % HistoryBeatmaps, i % 5),
+                {.timestamp = i * (365 * Day / HistoryPlays), .score = 1000000, .maxScore = 1100000, .accuracy = 0.9f + (i % 97) / 1000.0f}
+            );
+        }
+        created = true;
+    }
+    Plays::Open(directory.string());
+}
+
+static void BM_PlaysOpen(benchmark::State& state) {
+    OpenHistory();
+    auto directory = std::filesystem::temp_directory_path() / "metacore-benchmark-plays";
+    for (auto _ : state)
+        Plays::Open(directory.string());
+}
+BENCHMARK(BM_PlaysOpen)->Unit(benchmark::kMillisecond);
+
+static void BM_PlaysLastPlays(benchmark::State& state) {
+    OpenHistory();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Plays::GetLastPlays("custom_level_123Standard3", 10));
+}
+BENCHMARK(BM_PlaysLastPlays);
+
+static void BM_PlaysBestAccuracyTrend(benchmark::State& state) {
+    OpenHistory();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Plays::GetBestAccuracyTrend("custom_level_123Standard3"));
+}
+BENCHMARK(BM_PlaysBestAccuracyTrend);
+
+static void BM_PlaysAverageAccuracyWeek(benchmark::State& state) {
+    OpenHistory();
+    int64_t since = Plays::GetPlays().back().timestamp - 7 * Day;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Plays::GetAverageAccuracy(since));
+        benchmark::DoNotOptimize(Plays::GetAverageAccuracy("custom_level_123Standard3", since));
+    }
+}
+BENCHMARK(BM_PlaysAverageAccuracyWeek);
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include "ppmath.hpp"
+
+using namespace MetaCore;
+
+// accuracies spread over the range where the curves have the most points
+static float Accuracy(int i) {
+    return 0.85 + (i % 1500) * 0.0001;
+}
+
+static void BM_AccCurveBL(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(PP::AccCurve(Accuracy(i++), PP::BeatLeaderCurve));
+}
+BENCHMARK(BM_AccCurveBL);
+
+static void BM_AccCurveSS(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(PP::AccCurve(Accuracy(i++), PP::ScoreSaberCurve));
+}
+BENCHMARK(BM_AccCurveSS);
+
+static void BM_CurveTableBL(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(PP::BeatLeaderTable(Accuracy(i++)));
+}
+BENCHMARK(BM_CurveTableBL);
+
+static void BM_RuntimeCurveSS(benchmark::State& state) {
+    PP::Curve curve(PP::ScoreSaberCurve);
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(curve(Accuracy(i++)));
+}
+BENCHMARK(BM_RuntimeCurveSS);
+
+static void BM_CalculateBL(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(PP::CalculateBL(Accuracy(i++), 8.5, 10.2, 4.1));
+}
+BENCHMARK(BM_CalculateBL);
+
+static void BM_CalculateSS(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(PP::CalculateSS(Accuracy(i++), 9.7, false));
+}
+BENCHMARK(BM_CalculateSS);
+
+// the single versions over the same accuracies as the batch ones, for comparison
+static void BM_CalculateBLLoop(benchmark::State& state) {
+    std::vector<float> accuracies(state.range(0));
+    std::vector<float> results(state.range(0));
+    for (int i = 0; i < accuracies.size(); i++)
+        accuracies[i] = Accuracy(i);
+    for (auto _ : state) {
+        for (int i = 0; i < accuracies.size(); i++)
+            results[i] = PP::CalculateBL(accuracies[i], 8.5, 10.2, 4.1);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CalculateBLLoop)->Arg(1000);
+
+static void BM_CalculateSSLoop(benchmark::State& state) {
+    std::vector<float> accuracies(state.range(0));
+    std::vector<float> results(state.range(0));
+    for (int i = 0; i < accuracies.size(); i++)
+        accuracies[i] = Accuracy(i);
+    for (auto _ : state) {
+        for (int i = 0; i < accuracies.size(); i++)
+            results[i] = PP::CalculateSS(accuracies[i], 9.7, false);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CalculateSSLoop)->Arg(1000);
+
+static void BM_CalculateBLBatch(benchmark::State& state) {
+    std::vector<float> accuracies(state.range(0));
+    std::vector<float> results(state.range(0));
+    for (int i = 0; i < accuracies.size(); i++)
+        accuracies[i] = Accuracy(i);
+    for (auto _ : state) {
+        PP::CalculateBL(accuracies, results, 8.5, 10.2, 4.1);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CalculateBLBatch)->Arg(1000);
+
+static void BM_CalculateSSBatch(benchmark::State& state) {
+    std::vector<float> accuracies(state.range(0));
+    std::vector<float> results(state.range(0));
+    for (int i = 0; i < accuracies.size(); i++)
+        accuracies[i] = Accuracy(i);
+    for (auto _ : state) {
+        PP::CalculateSS(accuracies, results, 9.7, false);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CalculateSSBatch)->Arg(1000);
+
+static void BM_RequiredAccuracyBL(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(PP::RequiredAccuracyBL(200 + (i++ % 300), 8.5, 10.2, 4.1));
+}
+BENCHMARK(BM_RequiredAccuracyBL);
+
+static void BM_RequiredAccuracySS(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(PP::RequiredAccuracySS(200 + (i++ % 200), 9.7));
+}
+BENCHMARK(BM_RequiredAccuracySS);
@@ -0,0 +1,28 @@
+#include <benchmark/benchmark.h>
+
+#include "seqlock.hpp"
+
+using namespace MetaCore;
+
+// roughly the size of Stats::Snapshot
+struct BenchmarkSnapshot {
+    float values[56];
+};
+
+static void BM_SeqLockWrite(benchmark::State& state) {
+    SeqLock<BenchmarkSnapshot> lock;
+    BenchmarkSnapshot snapshot = {};
+    for (auto _ : state) {
+        snapshot.values[0]++;
+        lock.Write(snapshot);
+    }
+}
+BENCHMARK(BM_SeqLockWrite);
+
+static void BM_SeqLockRead(benchmark::State& state) {
+    SeqLock<BenchmarkSnapshot> lock;
+    lock.Write({});
+    for (auto _ : state)
+        benchmark::DoNotOptimize(lock.Read());
+}
+BENCHMARK(BM_SeqLockRead);
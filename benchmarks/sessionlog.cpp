@@ -0,0 +1,22 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include "session.hpp"
+
+using namespace MetaCore;
+
+// the cost added to each hook while a play is being logged
+static void BM_SessionLogRecord(benchmark::State& state) {
+    auto path = std::filesystem::temp_directory_path() / "metacore-benchmark.mcs";
+    SessionLog::Begin(path.string(), "benchmark");
+    SessionLog::Record record = {.type = SessionLog::RecordType::Cut};
+    for (auto _ : state) {
+        record.songTime += 0.01;
+        SessionLog::Log(record);
+    }
+    SessionLog::Finish();
+    SessionLog::Join();
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_SessionLogRecord);
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include "strings.hpp"
+
+using namespace MetaCore;
+
+static void BM_SecondsToString(benchmark::State& state) {
+    int i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Strings::SecondsToString(i++ % 7200, true));
+}
+BENCHMARK(BM_SecondsToString);
+
+static void BM_TimeAgoString(benchmark::State& state) {
+    long i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Strings::TimeAgoString(i++ * 997));
+}
+BENCHMARK(BM_TimeAgoString);
+
+static void BM_SanitizedPath(benchmark::State& state) {
+    std::string path = "Camellia - GHOST (Expert+) [mapped by someone?] <3.dat";
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Strings::SanitizedPath(path));
+}
+BENCHMARK(BM_SanitizedPath);
+
+static void BM_IEquals(benchmark::State& state) {
+    std::string a = "ExpertPlusStandard";
+    std::string b = "expertplusstandard";
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Strings::IEquals(a, b));
+}
+BENCHMARK(BM_IEquals);
+
+static void BM_Lower(benchmark::State& state) {
+    std::string string = "OneSaber_ExpertPlus_Lawless";
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Strings::Lower(string));
+}
+BENCHMARK(BM_Lower);
+
+static void BM_FormatDecimals(benchmark::State& state) {
+    double i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Strings::FormatDecimals(i += 0.37, 2));
+}
+BENCHMARK(BM_FormatDecimals);
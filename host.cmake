@@ -0,0 +1,76 @@
+project(MetaCoreHost CXX)
+
+# c++ standard
+set(CMAKE_CXX_STANDARD 20)
+set(CMAKE_CXX_STANDARD_REQUIRED 20)
+
+set(CMAKE_EXPORT_COMPILE_COMMANDS on)
+
+if(NOT CMAKE_BUILD_TYPE)
+    set(CMAKE_BUILD_TYPE Release)
+endif()
+
+set(SOURCE_DIR ${CMAKE_CURRENT_SOURCE_DIR}/src)
+set(SHARED_DIR ${CMAKE_CURRENT_SOURCE_DIR}/shared)
+set(INCLUDE_DIR ${CMAKE_CURRENT_SOURCE_DIR}/include)
+set(BENCHMARK_DIR ${CMAKE_CURRENT_SOURCE_DIR}/benchmarks)
+set(TOOLS_DIR ${CMAKE_CURRENT_SOURCE_DIR}/tools)
+set(TESTS_DIR ${CMAKE_CURRENT_SOURCE_DIR}/tests)
+
+find_package(fmt REQUIRED)
+
+# the sources that do not depend on the game or android
+add_library(
+    metacore-core STATIC
+    ${SOURCE_DIR}/counters.cpp
+    ${SOURCE_DIR}/events.cpp
+    ${SOURCE_DIR}/journal.cpp
+    ${SOURCE_DIR}/plays.cpp
+    ${SOURCE_DIR}/ppmath.cpp
+    ${SOURCE_DIR}/scoring.cpp
+    ${SOURCE_DIR}/sessionlog.cpp
+    ${SOURCE_DIR}/sharedstats.cpp
+    ${SOURCE_DIR}/strings.cpp
+    ${SOURCE_DIR}/timeline.cpp
+)
+
+target_include_directories(metacore-core PUBLIC ${SHARED_DIR})
+target_include_directories(metacore-core PUBLIC ${INCLUDE_DIR})
+
+target_compile_definitions(metacore-core PUBLIC METACORE_HOST)
+
+target_link_libraries(metacore-core PUBLIC fmt::fmt ${CMAKE_DL_LIBS})
+
+# reference reader for the shared stats file
+add_executable(metacore-stats-reader ${TOOLS_DIR}/statsreader.cpp)
+
+target_link_libraries(metacore-stats-reader PRIVATE metacore-core)
+
+find_package(benchmark QUIET)
+
+if(benchmark_FOUND)
+    file(GLOB benchmark_file_list ${BENCHMARK_DIR}/*.cpp)
+
+    add_executable(metacore-benchmarks ${benchmark_file_list})
+
+    target_link_libraries(metacore-benchmarks PRIVATE metacore-core benchmark::benchmark_main)
+else()
+    message(STATUS "google benchmark not found, skipping benchmarks")
+endif()
+
+find_package(GTest QUIET)
+
+if(GTest_FOUND)
+    enable_testing()
+
+    file(GLOB test_file_list ${TESTS_DIR}/*.cpp)
+
+    add_executable(metacore-tests ${test_file_list})
+
+    target_link_libraries(metacore-tests PRIVATE metacore-core GTest::gtest_main)
+
+    include(GoogleTest)
+    gtest_discover_tests(metacore-tests)
+else()
+    message(STATUS "googletest not found, skipping tests")
+endif()
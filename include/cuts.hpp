@@ -0,0 +1,21 @@
+#pragma once
+
+namespace MetaCore::Timeline {
+    // clears the timeline, reserving space for the notes of a new map
+    void Reset(int notes);
+    // adds a note to the end of the timeline
+    void Record(
+        int kind,
+        float time,
+        int saber,
+        int beforeCutScore,
+        int afterCutScore,
+        int centerCutScore,
+        float cutDistance,
+        float timeDeviation,
+        float cutAngle,
+        int multiplier
+    );
+    // adds a bad cut or miss to the end of the timeline, with no scores
+    void RecordMiss(int kind, float time, int saber, float cutDistance, float timeDeviation, float cutAngle, int multiplier);
+}
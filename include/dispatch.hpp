@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace MetaCore::Events {
+    // broadcasts everything queued by BroadcastAsync, in order, on the main thread
+    void RunAsyncBroadcasts();
+
+    // the data of the broadcast currently running callbacks, or nullptr if it has none, for global callbacks that need it
+    std::pair<void const*, size_t> CurrentPayload();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include "ppmath.hpp"
+
+namespace MetaCore::Stats {
+    // registers the callbacks that keep the live pp values up to date
+    void InstallLivePP();
+}
+
+namespace MetaCore::LivePP {
+    // everything that doesn't depend on the score, found once per play
+    struct Ratings {
+        bool hasBL = false;
+        bool hasSS = false;
+        // the beatleader pass, acc, and tech ratings with the modifiers of the play, before and after failing with no fail
+        std::tuple<float, float, float> bl = {};
+        std::tuple<float, float, float> blFailed = {};
+        float stars = 0;
+    };
+
+    // everything the pp values depend on, so they are only recalculated when something changes
+    struct Inputs {
+        int score;
+        int maxScore;
+        // the scoresaber modifier multiplier, which already includes the no fail penalty after failing
+        float modifierMultiplier;
+        bool failed;
+        bool noFail;
+
+        bool operator==(Inputs const&) const = default;
+    };
+
+    // calculates the beatleader and scoresaber pp, or 0 for each where the map isn't ranked or the play failed without no fail
+    inline std::pair<float, float> Calculate(Ratings const& ratings, Inputs const& inputs) {
+        if (inputs.failed && !inputs.noFail)
+            return {0, 0};
+        float accuracy = inputs.maxScore > 0 ? inputs.score / (float) inputs.maxScore : 1;
+        float bl = 0;
+        float ss = 0;
+        // beatleader applies modifiers to the ratings, and scoresaber to the score
+        if (ratings.hasBL) {
+            auto const [passRating, accRating, techRating] = inputs.failed ? ratings.blFailed : ratings.bl;
+            bl = PP::CalculateBL(accuracy, passRating, accRating, techRating);
+        }
+        // not passed as failed, since the multiplier would halve it again
+        if (ratings.hasSS)
+            ss = PP::CalculateSS(accuracy * inputs.modifierMultiplier, ratings.stars, false);
+        return {bl, ss};
+    }
+}
@@ -1,8 +1,36 @@
 #pragma once
 
+#ifdef METACORE_HOST
+#include <fmt/format.h>
+
+// minimal stand-in for paper when building the platform independent core outside of the game
+struct HostLogger {
+    template <class... TArgs>
+    void log(char const* level, fmt::format_string<TArgs...> format, TArgs&&... args) const {
+        fmt::print(stderr, "{}: {}\n", level, fmt::format(format, std::forward<TArgs>(args)...));
+    }
+    template <class... TArgs>
+    void debug(fmt::format_string<TArgs...> format, TArgs&&... args) const {}
+    template <class... TArgs>
+    void info(fmt::format_string<TArgs...> format, TArgs&&... args) const {
+        log("info", format, std::forward<TArgs>(args)...);
+    }
+    template <class... TArgs>
+    void warn(fmt::format_string<TArgs...> format, TArgs&&... args) const {
+        log("warn", format, std::forward<TArgs>(args)...);
+    }
+    template <class... TArgs>
+    void error(fmt::format_string<TArgs...> format, TArgs&&... args) const {
+        log("error", format, std::forward<TArgs>(args)...);
+    }
+};
+
+constexpr HostLogger logger;
+#else
 #include "beatsaber-hook/shared/utils/logging.hpp"
 
 constexpr auto logger = Paper::ConstLoggerContext(MOD_ID);
+#endif
 
 #define SLOW_UPDATES_PER_SEC 4
 #define BASE_GAME_ID "__vanilla_beat_games_not_a_mod_dont_use_thx"
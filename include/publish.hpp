@@ -0,0 +1,13 @@
+#pragma once
+
+#include "snapshot.hpp"
+
+namespace MetaCore::Stats {
+    // copies the current statistics into the snapshot that can be read from any thread
+    void PublishSnapshot();
+}
+
+namespace MetaCore::SharedStats {
+    // writes a snapshot to the shared stats file, if enabled
+    void Publish(Stats::Snapshot const& snapshot);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+
+#include "UnityEngine/Component.hpp"
+#include "UnityEngine/GameObject.hpp"
+#include "UnityEngine/Object.hpp"
+#include "UnityEngine/SceneManagement/Scene.hpp"
+#include "types.hpp"
+
+namespace MetaCore::Registry {
+    // the most recently constructed instance of each type, set by constructor hooks that can run on loading threads
+    // and for prefabs, so it is only trusted once Get checks it from the main thread
+    template <class T>
+    inline std::atomic<T*> constructed = nullptr;
+
+    // the last checked instance of each type
+    template <class T>
+    inline T* instance = nullptr;
+
+    // clears the instance when the object is destroyed, keyed by the component itself in case its game object changes
+    template <class T>
+    void Watch(T* object) {
+        // keep any other callback for the same object
+        auto& onDestroy = ObjectSignal::onDestroys[object->GetInstanceID()];
+        onDestroy = [object, previous = std::move(onDestroy)]() {
+            if (instance<T> == object)
+                instance<T> = nullptr;
+            if (previous)
+                previous();
+        };
+    }
+
+    // checks that an object is alive and part of a loaded scene, rather than a prefab or an asset
+    template <class T>
+    bool IsInScene(T* object) {
+        if (!UnityW<T>(object))
+            return false;
+        if constexpr (std::is_convertible_v<T*, UnityEngine::Component*>) {
+            auto scene = object->get_gameObject()->get_scene();
+            return scene.IsValid() && scene.get_isLoaded();
+        }
+        return true;
+    }
+
+    // registers a newly constructed instance of a type, to be called from its constructor hook
+    // nothing can be called on the object yet, since it is still being constructed and possibly not on the main thread
+    template <class T>
+    void Register(T* object) {
+        constructed<T> = object;
+    }
+
+    // gets the registered instance of a type, searching the scene only if none was found since the mod loaded
+    template <class T>
+    T* Get(bool search = true) {
+        if (auto object = constructed<T>.exchange(nullptr); object && object != instance<T> && IsInScene(object)) {
+            instance<T> = object;
+            Watch(object);
+        }
+        // in case the instance was destroyed without the callback running
+        if (instance<T> && !UnityW<T>(instance<T>))
+            instance<T> = nullptr;
+        if (!instance<T> && search) {
+            instance<T> = UnityEngine::Object::FindObjectOfType<T*>(true);
+            if (instance<T>)
+                Watch(instance<T>);
+        }
+        return instance<T>;
+    }
+}
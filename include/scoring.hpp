@@ -0,0 +1,15 @@
+#pragma once
+
+#include <vector>
+
+namespace MetaCore::Scoring {
+    // a note or chain element that adds to the max score
+    struct Element {
+        float time;
+        int maxCutScore;
+    };
+
+    // sorts the elements by time, keeping the order of simultaneous ones, and fills in the total max score up to and including each one,
+    // ramping the multiplier like ScoreMultiplierCounter to match ScoreModel::ComputeMaxMultipliedScoreForBeatmap
+    void ComputeMaxScores(std::vector<Element>& elements, std::vector<float>& times, std::vector<int>& totals);
+}
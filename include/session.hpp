@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+#include "sessionlog.hpp"
+
+namespace MetaCore::SessionLog {
+    // starts logging to a file, finishing any current log
+    bool Begin(std::string const& path, std::string const& beatmap);
+    // starts logging to the enabled directory, if any
+    void BeginAuto(std::string const& beatmap);
+    // copies a record into the current block, handing it to the writer thread when full
+    void Log(Record const& record);
+    // hands the remaining records to the writer thread, which writes them and the index and closes the file
+    void Finish();
+    // waits for the writer thread of the last log to finish, done automatically by the next Begin
+    void Join();
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <vector>
+
+namespace MetaCore {
+    /// @brief Aggregates over a sliding window of the most recent samples, with amortized O(1) updates and O(1) queries
+    struct Window {
+        /// @brief Constructor for an empty Window
+        /// @param length The number of most recent samples to aggregate over, minimum 1
+        Window(int length) : values(std::max(length, 1)) {}
+
+        /// @brief Adds a new sample, discarding the oldest one in the window if full
+        /// @param value The sample to add
+        void push(float value) {
+            int length = values.size();
+            if (added >= length)
+                total -= values[added % length];
+            values[added % length] = value;
+            total += value;
+            // monotonic queues of the indices that can still become the max or min
+            while (!highest.empty() && values[highest.back() % length] <= value)
+                highest.pop_back();
+            highest.push_back(added);
+            while (!lowest.empty() && values[lowest.back() % length] >= value)
+                lowest.pop_back();
+            lowest.push_back(added);
+            added++;
+            if (highest.front() <= added - 1 - length)
+                highest.pop_front();
+            if (lowest.front() <= added - 1 - length)
+                lowest.pop_front();
+        }
+
+        /// @brief Removes all samples
+        void clear() {
+            added = 0;
+            total = 0;
+            highest.clear();
+            lowest.clear();
+        }
+
+        /// @brief Finds the number of samples in the window
+        /// @return The number of samples, at most the window length
+        int size() const { return std::min(added, (int) values.size()); }
+
+        /// @brief Finds the sum of the samples in the window
+        /// @return The sum of the samples, or 0 if there are none
+        float sum() const { return total; }
+
+        /// @brief Finds the mean of the samples in the window
+        /// @return The mean of the samples, or 0 if there are none
+        float mean() const { return added == 0 ? 0 : total / size(); }
+
+        /// @brief Finds the highest sample in the window
+        /// @return The highest sample, or 0 if there are none
+        float max() const { return highest.empty() ? 0 : values[highest.front() % values.size()]; }
+
+        /// @brief Finds the lowest sample in the window
+        /// @return The lowest sample, or 0 if there are none
+        float min() const { return lowest.empty() ? 0 : values[lowest.front() % values.size()]; }
+
+       protected:
+        std::vector<float> values;
+        int added = 0;
+        double total = 0;
+        std::deque<int> highest;
+        std::deque<int> lowest;
+    };
+
+    /// @brief A fixed capacity ring buffer of samples that also keeps aggregates of every sample ever added
+    /// @tparam Capacity The number of most recent samples to keep
+    template <int Capacity>
+    struct History {
+        static_assert(Capacity > 0, "History capacity must be positive");
+
+        /// @brief Adds a new sample, discarding the oldest stored one if at Capacity
+        /// @param value The sample to add
+        void push(float value) {
+            values[next] = value;
+            next = (next + 1) % Capacity;
+            if (stored < Capacity)
+                stored++;
+            added++;
+            total += value;
+            highest = std::max(highest, value);
+            for (auto& entry : windows)
+                entry.window.push(value);
+        }
+
+        /// @brief Removes all samples and resets the aggregates
+        void clear() {
+            next = 0;
+            stored = 0;
+            added = 0;
+            total = 0;
+            highest = 0;
+            for (auto& entry : windows)
+                entry.window.clear();
+        }
+
+        /// @brief Gets the number of samples that can be stored
+        /// @return The Capacity template parameter
+        static constexpr int capacity() { return Capacity; }
+
+        /// @brief Finds the number of samples currently stored, at most Capacity
+        /// @return The number of stored samples
+        int size() const { return stored; }
+
+        /// @brief Finds the number of samples added since the last clear, including discarded ones
+        /// @return The number of added samples
+        int count() const { return added; }
+
+        /// @brief Finds the sum of all samples added since the last clear
+        /// @return The sum of the samples, or 0 if there are none
+        double sum() const { return total; }
+
+        /// @brief Finds the highest sample added since the last clear
+        /// @return The highest sample, or 0 if there are none or all are negative
+        float max() const { return highest; }
+
+        /// @brief Finds the mean of all samples added since the last clear
+        /// @return The mean of the samples, or 0 if there are none
+        float mean() const { return added == 0 ? 0 : total / added; }
+
+        /// @brief Finds the sum of the most recent samples
+        /// @param last The number of samples to include, limited to the number stored
+        /// @return The sum of the samples, or 0 if there are none
+        float sum(int last) const {
+            float ret = 0;
+            for (int i = std::max(0, stored - last); i < stored; i++)
+                ret += (*this)[i];
+            return ret;
+        }
+
+        /// @brief Finds the highest of the most recent samples
+        /// @param last The number of samples to include, limited to the number stored
+        /// @return The highest sample, or 0 if there are none or all are negative
+        float max(int last) const {
+            float ret = 0;
+            for (int i = std::max(0, stored - last); i < stored; i++)
+                ret = std::max(ret, (*this)[i]);
+            return ret;
+        }
+
+        /// @brief The most windows kept up to date at once, after which the least recently retrieved one is replaced
+        static constexpr int MaxWindows = 8;
+
+        /// @brief Retrieves a sliding window over this history, which is kept up to date as samples are added
+        /// @param length The number of most recent samples in the window, limited to Capacity
+        /// @return The window, filled with up to length of the currently stored samples if it was just created
+        /// @note The reference may be invalidated by the next call with a different length
+        Window& window(int length) {
+            length = std::clamp(length, 1, Capacity);
+            uses++;
+            TrackedWindow* oldest = nullptr;
+            for (auto& entry : windows) {
+                if (entry.length == length) {
+                    entry.used = uses;
+                    return entry.window;
+                }
+                if (!oldest || entry.used < oldest->used)
+                    oldest = &entry;
+            }
+            if (windows.size() < MaxWindows) {
+                windows.reserve(MaxWindows);
+                oldest = &windows.emplace_back(TrackedWindow{length, uses, Window(length)});
+            }
+            else
+                *oldest = TrackedWindow{length, uses, Window(length)};
+            for (int i = std::max(0, stored - length); i < stored; i++)
+                oldest->window.push((*this)[i]);
+            return oldest->window;
+        }
+
+        /// @brief Retrieves a stored sample, ordered from oldest to newest
+        /// @param index The index of the sample, from 0 to size() - 1
+        /// @return The sample at the index
+        float operator[](int index) const { return values[(next - stored + index + Capacity) % Capacity]; }
+
+       protected:
+        std::array<float, Capacity> values = {};
+        int next = 0;
+        int stored = 0;
+        int added = 0;
+        double total = 0;
+        float highest = 0;
+
+        struct TrackedWindow {
+            int length;
+            int used;
+            Window window;
+        };
+        int uses = 0;
+        std::vector<TrackedWindow> windows;
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "export.h"
+
+// the scalar statistics of internals.hpp, split out so they don't depend on the game
+// no per-variable documentation here either, sorry
+
+namespace MetaCore::Internals {
+    METACORE_EXPORT extern int leftScore;
+    METACORE_EXPORT extern int rightScore;
+    METACORE_EXPORT extern int leftMaxScore;
+    METACORE_EXPORT extern int rightMaxScore;
+    METACORE_EXPORT extern int songMaxScore;
+    METACORE_EXPORT extern int leftCombo;
+    METACORE_EXPORT extern int rightCombo;
+    METACORE_EXPORT extern int combo;
+    METACORE_EXPORT extern int highestLeftCombo;
+    METACORE_EXPORT extern int highestRightCombo;
+    METACORE_EXPORT extern int highestCombo;
+    METACORE_EXPORT extern int multiplier;
+    METACORE_EXPORT extern int multiplierProgress;
+    METACORE_EXPORT extern float health;
+    METACORE_EXPORT extern float songTime;
+    METACORE_EXPORT extern float songLength;
+    METACORE_EXPORT extern float songSpeed;
+    METACORE_EXPORT extern int notesLeftCut;
+    METACORE_EXPORT extern int notesRightCut;
+    METACORE_EXPORT extern int notesLeftBadCut;
+    METACORE_EXPORT extern int notesRightBadCut;
+    METACORE_EXPORT extern int notesLeftMissed;
+    METACORE_EXPORT extern int notesRightMissed;
+    METACORE_EXPORT extern int bombsLeftHit;
+    METACORE_EXPORT extern int bombsRightHit;
+    METACORE_EXPORT extern int wallsHit;
+    METACORE_EXPORT extern int uncountedNotesLeftCut;
+    METACORE_EXPORT extern int uncountedNotesRightCut;
+    METACORE_EXPORT extern int remainingNotesLeft;
+    METACORE_EXPORT extern int remainingNotesRight;
+    METACORE_EXPORT extern int songNotesLeft;
+    METACORE_EXPORT extern int songNotesRight;
+    METACORE_EXPORT extern int leftPreSwing;
+    METACORE_EXPORT extern int rightPreSwing;
+    METACORE_EXPORT extern int leftPostSwing;
+    METACORE_EXPORT extern int rightPostSwing;
+    METACORE_EXPORT extern int leftAccuracy;
+    METACORE_EXPORT extern int rightAccuracy;
+    METACORE_EXPORT extern float leftTimeDependence;
+    METACORE_EXPORT extern float rightTimeDependence;
+    METACORE_EXPORT extern bool noFail;
+    METACORE_EXPORT extern float positiveMods;
+    METACORE_EXPORT extern float negativeMods;
+    METACORE_EXPORT extern int personalBest;
+    METACORE_EXPORT extern int fails;
+    METACORE_EXPORT extern int restarts;
+    METACORE_EXPORT extern int leftMissedMaxScore;
+    METACORE_EXPORT extern int rightMissedMaxScore;
+    METACORE_EXPORT extern int leftMissedFixedScore;
+    METACORE_EXPORT extern int rightMissedFixedScore;
+}
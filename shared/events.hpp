@@ -1,6 +1,8 @@
 #pragma once
 
+#include <concepts>
 #include <functional>
+#include <map>
 #include <string>
 
 #include "export.h"
@@ -55,17 +57,29 @@ namespace MetaCore::Events {
         EventMax = SoftRestart,
     };
 
+    /// @brief A type of data that can be broadcast with an event, such as the ones in payloads.hpp
+    template <class T>
+    concept Payload = std::is_trivially_copyable_v<T> && requires {
+        { T::Event } -> std::convertible_to<int>;
+    };
+
     /// @brief Registers a custom event for future broadcasts
     /// @param mod The unique id of the mod registering the event
     /// @param modEvent The per-mod id of the event being registered
     /// @return The unique global id of the registered event (> EventMax), or -1 on failure
+    /// @note The global id can be kept and used instead of the mod and per-mod id, which avoids looking up the event by string each time
     METACORE_EXPORT int RegisterEvent(std::string mod, int modEvent);
 
     /// @brief Finds the unique global id of a custom event
     /// @param mod The unique id of the mod that registered the event
     /// @param modEvent The per-mod id of the registered event
     /// @return The unique global id of the event, or -1 if it does not exist
+    /// @note The global id can be kept and used instead of the mod and per-mod id, which avoids looking up the event by string each time
     METACORE_EXPORT int FindEvent(std::string mod, int modEvent);
+    /// @brief Finds the mod and per-mod id of a custom event
+    /// @param event The unique global id of the event
+    /// @return The unique id of the mod and the per-mod id of the event, or an empty string and -1 if it is not a custom event
+    METACORE_EXPORT std::pair<std::string, int> FindEvent(int event);
 
     /// @brief Registers a callback to an event
     /// @param event The global id of the event
@@ -73,6 +87,13 @@ namespace MetaCore::Events {
     /// @param once If the callback should only be called once and then removed
     /// @return The id for removal if the event was successfully registered to (>= 0), or -1 on failure
     METACORE_EXPORT int AddCallback(int event, std::function<void()> callback, bool once = false);
+    /// @brief Registers a callback to an event, optionally coalescing multiple broadcasts into one call
+    /// @param event The global id of the event
+    /// @param callback The function to be called when the event is broadcast
+    /// @param once If the callback should only be called once and then removed
+    /// @param coalesce If the callback should be called at most once per frame, right before the Update event, if the event was broadcast since then
+    /// @return The id for removal if the event was successfully registered to (>= 0), or -1 on failure
+    METACORE_EXPORT int AddCallback(int event, std::function<void()> callback, bool once, bool coalesce);
     /// @brief Registers a callback to an event
     /// @param mod The unique id of the mod that registered the event
     /// @param modEvent The per-mod id of the event
@@ -85,6 +106,21 @@ namespace MetaCore::Events {
     /// @param once If the callback should only be called once and then removed
     /// @return The id for removal (>= 0)
     METACORE_EXPORT int AddCallback(std::function<void(int)> callback, bool once = false);
+    /// @brief Registers a callback to the data of an event, only called when the event is broadcast with data
+    /// @param event The global id of the event
+    /// @param callback The function to be called with the broadcast data
+    /// @param once If the callback should only be called once and then removed
+    /// @return The id for removal if the event was successfully registered to (>= 0), or -1 on failure
+    METACORE_EXPORT int AddPayloadCallback(int event, std::function<void(void const*)> callback, bool once = false);
+    /// @brief Registers a callback to the data of an event, only called when the event is broadcast with data
+    /// @tparam T The type of the data, which determines the event
+    /// @param callback The function to be called with the broadcast data
+    /// @param once If the callback should only be called once and then removed
+    /// @return The id for removal if the event was successfully registered to (>= 0), or -1 on failure
+    template <Payload T>
+    int AddCallback(std::function<void(T const&)> callback, bool once = false) {
+        return AddPayloadCallback(T::Event, [callback = std::move(callback)](void const* data) { callback(*(T const*) data); }, once);
+    }
 
     /// @brief Removes a previously registered callback
     /// @param id The id returned by a call to AddCallback
@@ -93,12 +129,79 @@ namespace MetaCore::Events {
     /// @brief Globally broadcasts an event
     /// @param event The global id of the event
     /// @return If the event was successfully broadcast
+    /// @note If the event is already being broadcast, it will be broadcast again after that finishes, up to 8 times recursively
     METACORE_EXPORT bool Broadcast(int event);
     /// @brief Globally broadcasts an event
     /// @param mod The unique id of the mod that registered the event
     /// @param modEvent The per-mod id of the event
     /// @return If the event was successfully broadcast
     METACORE_EXPORT bool Broadcast(std::string mod, int modEvent);
+    /// @brief Globally broadcasts an event with data for payload callbacks
+    /// @param event The global id of the event
+    /// @param data A pointer to the data, only valid for the duration of the broadcast
+    /// @param size The size of the data in bytes
+    /// @return If the event was successfully broadcast
+    METACORE_EXPORT bool Broadcast(int event, void const* data, size_t size);
+    /// @brief Globally broadcasts an event with data for payload callbacks
+    /// @tparam T The type of the data, which determines the event
+    /// @param data The data to broadcast
+    /// @return If the event was successfully broadcast
+    template <Payload T>
+    bool Broadcast(T const& data) {
+        return Broadcast(T::Event, &data, sizeof(T));
+    }
+
+    /// @brief Queues an event to be broadcast on the main thread, safe to call from any thread without locking
+    /// @param event The global id of the event, ignored if invalid when broadcast
+    METACORE_EXPORT void BroadcastAsync(int event);
+    /// @brief Queues an event with data to be broadcast on the main thread, safe to call from any thread without locking
+    /// @param event The global id of the event, ignored if invalid when broadcast
+    /// @param data A pointer to the data, which will be copied
+    /// @param size The size of the data in bytes
+    METACORE_EXPORT void BroadcastAsync(int event, void const* data, size_t size);
+    /// @brief Queues an event with data to be broadcast on the main thread, safe to call from any thread without locking
+    /// @tparam T The type of the data, which determines the event
+    /// @param data The data to broadcast, which will be copied
+    template <Payload T>
+    void BroadcastAsync(T const& data) {
+        BroadcastAsync(T::Event, &data, sizeof(T));
+    }
+
+    /// @brief Timing statistics for callbacks while profiling, in microseconds
+    struct CallbackStats {
+        // The total number of timed callbacks
+        int count = 0;
+        // The average time of all timed callbacks
+        float mean = 0;
+        // The 99th percentile time of the last 256 timed callbacks
+        float p99 = 0;
+        // The longest time of all timed callbacks
+        float max = 0;
+    };
+
+    /// @brief Enables or disables timing of every callback, attributed to its event and the mod that registered it
+    /// @param enabled If callbacks should be timed
+    METACORE_EXPORT void SetProfiling(bool enabled);
+    /// @brief Gets if callbacks are currently being timed
+    /// @return If profiling is enabled
+    METACORE_EXPORT bool IsProfiling();
+    /// @brief Clears all timing statistics collected so far
+    METACORE_EXPORT void ResetProfiling();
+    /// @brief Gets the timing statistics for all callbacks of an event, including global callbacks
+    /// @param event The global id of the event
+    /// @return The timing statistics, or empty statistics if none were collected
+    METACORE_EXPORT CallbackStats GetEventStats(int event);
+    /// @brief Gets the timing statistics for all callbacks registered by a mod
+    /// @param mod The library name of the mod, without the "lib" prefix or ".so" suffix
+    /// @return The timing statistics, or empty statistics if none were collected
+    METACORE_EXPORT CallbackStats GetModStats(std::string mod);
+    /// @brief Gets the timing statistics for every mod with timed callbacks
+    /// @return The timing statistics by mod library name
+    METACORE_EXPORT std::map<std::string, CallbackStats> GetAllModStats();
+    /// @brief Writes all timing statistics to a file, in csv format
+    /// @param path The path of the file to write
+    /// @return If the file was successfully written
+    METACORE_EXPORT bool DumpProfiling(std::string path);
 }
 
 #define CONCAT_WRAPPED(x, y) x##y
@@ -15,65 +15,27 @@
 #include "GlobalNamespace/ScoreController.hpp"
 #include "UnityEngine/Camera.hpp"
 #include "UnityEngine/Quaternion.hpp"
+#include "aggregates.hpp"
+#include "counters.hpp"
 #include "export.h"
 
 // no per-variable documentation here, sorry
 
 namespace MetaCore::Internals {
-    METACORE_EXPORT extern int leftScore;
-    METACORE_EXPORT extern int rightScore;
-    METACORE_EXPORT extern int leftMaxScore;
-    METACORE_EXPORT extern int rightMaxScore;
-    METACORE_EXPORT extern int songMaxScore;
-    METACORE_EXPORT extern int leftCombo;
-    METACORE_EXPORT extern int rightCombo;
-    METACORE_EXPORT extern int combo;
-    METACORE_EXPORT extern int highestLeftCombo;
-    METACORE_EXPORT extern int highestRightCombo;
-    METACORE_EXPORT extern int highestCombo;
-    METACORE_EXPORT extern int multiplier;
-    METACORE_EXPORT extern int multiplierProgress;
-    METACORE_EXPORT extern float health;
-    METACORE_EXPORT extern float songTime;
-    METACORE_EXPORT extern float songLength;
-    METACORE_EXPORT extern float songSpeed;
-    METACORE_EXPORT extern int notesLeftCut;
-    METACORE_EXPORT extern int notesRightCut;
-    METACORE_EXPORT extern int notesLeftBadCut;
-    METACORE_EXPORT extern int notesRightBadCut;
-    METACORE_EXPORT extern int notesLeftMissed;
-    METACORE_EXPORT extern int notesRightMissed;
-    METACORE_EXPORT extern int bombsLeftHit;
-    METACORE_EXPORT extern int bombsRightHit;
-    METACORE_EXPORT extern int wallsHit;
-    METACORE_EXPORT extern int uncountedNotesLeftCut;
-    METACORE_EXPORT extern int uncountedNotesRightCut;
-    METACORE_EXPORT extern int remainingNotesLeft;
-    METACORE_EXPORT extern int remainingNotesRight;
-    METACORE_EXPORT extern int songNotesLeft;
-    METACORE_EXPORT extern int songNotesRight;
-    METACORE_EXPORT extern int leftPreSwing;
-    METACORE_EXPORT extern int rightPreSwing;
-    METACORE_EXPORT extern int leftPostSwing;
-    METACORE_EXPORT extern int rightPostSwing;
-    METACORE_EXPORT extern int leftAccuracy;
-    METACORE_EXPORT extern int rightAccuracy;
-    METACORE_EXPORT extern float leftTimeDependence;
-    METACORE_EXPORT extern float rightTimeDependence;
+    // the scalar statistics are in counters.hpp
+
+    // sampled SLOW_UPDATES_PER_SEC times per second
+    // deprecated: no longer filled since they grew for the whole map, only kept so mods built against older versions still load
     METACORE_EXPORT extern std::vector<float> leftSpeeds;
     METACORE_EXPORT extern std::vector<float> rightSpeeds;
     METACORE_EXPORT extern std::vector<float> leftAngles;
     METACORE_EXPORT extern std::vector<float> rightAngles;
-    METACORE_EXPORT extern bool noFail;
-    METACORE_EXPORT extern float positiveMods;
-    METACORE_EXPORT extern float negativeMods;
-    METACORE_EXPORT extern int personalBest;
-    METACORE_EXPORT extern int fails;
-    METACORE_EXPORT extern int restarts;
-    METACORE_EXPORT extern int leftMissedMaxScore;
-    METACORE_EXPORT extern int rightMissedMaxScore;
-    METACORE_EXPORT extern int leftMissedFixedScore;
-    METACORE_EXPORT extern int rightMissedFixedScore;
+    // the most recent samples, with running aggregates over the map and recent windows
+    using SaberHistory = History<1024>;
+    METACORE_EXPORT extern SaberHistory leftSpeedHistory;
+    METACORE_EXPORT extern SaberHistory rightSpeedHistory;
+    METACORE_EXPORT extern SaberHistory leftAngleHistory;
+    METACORE_EXPORT extern SaberHistory rightAngleHistory;
     METACORE_EXPORT extern UnityEngine::Quaternion prevRotLeft;
     METACORE_EXPORT extern UnityEngine::Quaternion prevRotRight;
 
@@ -101,6 +63,7 @@ namespace MetaCore::Internals {
     METACORE_EXPORT void Initialize();
     METACORE_EXPORT void DoSlowUpdate();
     METACORE_EXPORT void Finish(bool quit, bool restart);
+    METACORE_EXPORT int GetMaxScoreAtTime(float time);
 
     METACORE_EXPORT extern GlobalNamespace::BeatmapKey selectedKey;
     METACORE_EXPORT extern GlobalNamespace::BeatmapLevel* selectedLevel;
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "export.h"
+
+namespace MetaCore::Journal {
+    /// @brief A copy of the scalar statistics in counters.hpp, recorded with each event
+    struct Counters {
+        int leftScore;
+        int rightScore;
+        int leftMaxScore;
+        int rightMaxScore;
+        int songMaxScore;
+        int leftCombo;
+        int rightCombo;
+        int combo;
+        int highestLeftCombo;
+        int highestRightCombo;
+        int highestCombo;
+        int multiplier;
+        int multiplierProgress;
+        float health;
+        float songTime;
+        float songLength;
+        float songSpeed;
+        int notesLeftCut;
+        int notesRightCut;
+        int notesLeftBadCut;
+        int notesRightBadCut;
+        int notesLeftMissed;
+        int notesRightMissed;
+        int bombsLeftHit;
+        int bombsRightHit;
+        int wallsHit;
+        int uncountedNotesLeftCut;
+        int uncountedNotesRightCut;
+        int remainingNotesLeft;
+        int remainingNotesRight;
+        int songNotesLeft;
+        int songNotesRight;
+        int leftPreSwing;
+        int rightPreSwing;
+        int leftPostSwing;
+        int rightPostSwing;
+        int leftAccuracy;
+        int rightAccuracy;
+        float leftTimeDependence;
+        float rightTimeDependence;
+        int noFail;
+        float positiveMods;
+        float negativeMods;
+        int personalBest;
+        int fails;
+        int restarts;
+        int leftMissedMaxScore;
+        int rightMissedMaxScore;
+        int leftMissedFixedScore;
+        int rightMissedFixedScore;
+    };
+
+    /// @brief Gets the current values of the statistics in counters.hpp
+    /// @return The current statistics
+    METACORE_EXPORT Counters GetCounters();
+    /// @brief Overwrites the statistics in counters.hpp, for example when replaying a journal
+    /// @param counters The new statistics
+    METACORE_EXPORT void SetCounters(Counters const& counters);
+
+    /// @brief Starts recording every broadcast event, its data, and the statistics it changed to a file, stopping any current recording
+    /// @param path The path of the file to write, which will be overwritten
+    /// @return If the file was successfully opened
+    METACORE_EXPORT bool StartRecording(std::string path);
+    /// @brief Stops and closes the current recording, if any
+    METACORE_EXPORT void StopRecording();
+    /// @brief Gets if events are currently being recorded
+    /// @return If a recording is in progress
+    METACORE_EXPORT bool IsRecording();
+
+    /// @brief Enables or disables automatically recording a journal for every play, from GameplaySceneStarted to GameplaySceneEnded
+    /// @param enabled If plays should be recorded
+    /// @param directory The directory to write the journals to, named by the time they were started
+    METACORE_EXPORT void SetAutoRecord(bool enabled, std::string directory = "");
+
+    /// @brief Feeds a recorded journal back through Events::Broadcast on the calling thread, blocking until finished
+    /// @param path The path of the journal file
+    /// @param speed The speed relative to the original timing, or <= 0 to replay as fast as possible
+    /// @param apply The function to restore the recorded statistics before each event is broadcast
+    /// @return The number of events broadcast, or -1 if the file could not be read
+    /// @note Event data is replayed byte for byte, so pointers in it (such as the notes in payloads.hpp) are from the recorded session and must not be used
+    METACORE_EXPORT int Replay(std::string path, float speed = 0, std::function<void(Counters const&)> apply = SetCounters);
+}
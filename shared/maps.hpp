@@ -30,7 +30,7 @@ namespace MetaCore {
         /// @param value The value to add or overwrite
         void push(K key, V value) {
             if (map.contains(key)) {
-                map[std::move(key)]->value = value;
+                map[std::move(key)]->value = std::move(value);
                 return;
             }
             Entry* entry = new Entry();
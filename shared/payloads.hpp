@@ -0,0 +1,102 @@
+#pragma once
+
+#include "GlobalNamespace/CutScoreBuffer.hpp"
+#include "GlobalNamespace/NoteCutInfo.hpp"
+#include "GlobalNamespace/NoteData.hpp"
+#include "events.hpp"
+
+// the values of saber fields match the constants in stats.hpp
+
+namespace MetaCore::Events {
+    /// @brief The data broadcast with every NoteCut event
+    struct NoteCutPayload {
+        static constexpr int Event = NoteCut;
+
+        // The saber that cut the note
+        int saber;
+        // The data of the note that was cut
+        GlobalNamespace::NoteData* note;
+        // The cut information from the game
+        GlobalNamespace::NoteCutInfo info;
+        // The finished score buffer for the cut, or nullptr for bad cuts
+        GlobalNamespace::CutScoreBuffer* buffer;
+        // If the cut was good (allIsOK)
+        bool good;
+        // If the cut was good and counted in swing statistics (see Stats::ShouldCountNote)
+        bool counted;
+        // The pre swing score, or 0 for bad cuts
+        int beforeCutScore;
+        // The post swing score, or 0 for bad cuts (30 for notes with no post swing, matching the statistics)
+        int afterCutScore;
+        // The accuracy score, or 0 for bad cuts
+        int centerCutScore;
+        // The distance of the cut from the center of the note
+        float cutDistance;
+        // The difference between the time of the cut and the time of the note
+        float timeDeviation;
+        // The song time when the event was broadcast
+        float songTime;
+    };
+
+    /// @brief The data broadcast with every NoteMissed event
+    struct NoteMissedPayload {
+        static constexpr int Event = NoteMissed;
+
+        // The saber the note was for
+        int saber;
+        // The data of the note that was missed
+        GlobalNamespace::NoteData* note;
+        // If the note is counted in statistics (see Stats::ShouldCountNote)
+        bool counted;
+        // The song time when the event was broadcast
+        float songTime;
+    };
+
+    /// @brief The data broadcast with every BombCut event
+    struct BombCutPayload {
+        static constexpr int Event = BombCut;
+
+        // The saber that cut the bomb
+        int saber;
+        // The data of the bomb that was cut
+        GlobalNamespace::NoteData* note;
+        // The cut information from the game
+        GlobalNamespace::NoteCutInfo info;
+        // The song time when the event was broadcast
+        float songTime;
+    };
+
+    /// @brief The data broadcast with every ScoreChanged event
+    struct ScoreChangedPayload {
+        static constexpr int Event = ScoreChanged;
+
+        // The saber the score changed for, or BothSabers if caused by a modifier change (failing with No Fail)
+        int saber;
+        // The data of the note that was scored, or nullptr if caused by a modifier change
+        GlobalNamespace::NoteData* note;
+        // The score added, including the multiplier
+        int scoreDelta;
+        // The maximum score added, including the maximum multiplier
+        int maxScoreDelta;
+        // The multiplier applied to the score
+        int multiplier;
+        // If the note was cut badly enough to lose its combo
+        bool badCut;
+        // The song time when the event was broadcast
+        float songTime;
+    };
+
+    /// @brief The data broadcast with every HealthChanged event
+    struct HealthChangedPayload {
+        static constexpr int Event = HealthChanged;
+
+        // The new health / energy
+        float health;
+        // The change in health / energy, after clamping
+        float change;
+        // If the health / energy has reached 0 during this map
+        bool failed;
+        // The song time when the event was broadcast
+        float songTime;
+    };
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "export.h"
+
+// plays are only recorded after a history is opened, and all functions must be called from the main thread
+// spans are invalidated by the next recorded play, so they should not be kept
+
+namespace MetaCore::Plays {
+    /// @brief A summary of a single play, recorded when the map ends (including by quitting, but not restarting)
+    struct Play {
+        /// @brief The time the play ended, in milliseconds since the unix epoch
+        int64_t timestamp;
+        /// @brief The id of the beatmap key of the play, which can be converted with GetBeatmap
+        uint32_t beatmap;
+        /// @brief The enabled modifiers, as a mask of PP::Modifier bits
+        uint32_t modifiers;
+        /// @brief The score, with modifiers
+        int32_t score;
+        /// @brief The max score of the notes played, without modifiers
+        int32_t maxScore;
+        /// @brief The accuracy value from 0 to 1, without modifiers
+        float accuracy;
+        /// @brief The number of missed and badly cut notes
+        int32_t misses;
+        int32_t pauses;
+        /// @brief The song time when the play ended, in seconds
+        float duration;
+        float songLength;
+        bool fullCombo;
+        bool quit;
+        bool failed;
+        /// @brief Always 0, so that every byte written to the history is set
+        uint8_t reserved = 0;
+
+        /// @brief Gets if the play reached the end of the map without quitting or failing
+        /// @return If the play was finished
+        bool finished() const { return !quit && !failed; }
+    };
+    static_assert(sizeof(Play) == 48, "plays are stored directly in the history file, so their layout should be fixed");
+
+    /// @brief Loads or creates the history stored in a directory, closing any currently open one
+    /// @param directory The directory with the history files, which will be created if it doesn't exist
+    /// @return If the history was loaded successfully
+    METACORE_EXPORT bool Open(std::string directory);
+    /// @brief Closes the current history, stopping plays from being recorded
+    METACORE_EXPORT void Close();
+    /// @brief Gets if a history is open and plays are being recorded
+    /// @return If a history is open
+    METACORE_EXPORT bool IsOpen();
+
+    /// @brief Appends a play to the current history
+    /// @param beatmap The serialized beatmap key of the play
+    /// @param play The play summary, which will have its beatmap id set and timestamp adjusted to be after all existing plays
+    METACORE_EXPORT void Add(std::string const& beatmap, Play play);
+
+    /// @brief Gets the serialized beatmap key of a beatmap id in the current history
+    /// @param id The beatmap id of a play
+    /// @return The serialized beatmap key, or an empty string if the id is not found
+    METACORE_EXPORT std::string GetBeatmap(uint32_t id);
+
+    /// @brief Gets every play in the current history
+    /// @return The plays, ordered from oldest to newest
+    METACORE_EXPORT std::span<Play const> GetPlays();
+    /// @brief Gets the plays in the current history that ended in a time range
+    /// @param start The earliest time to include, in milliseconds since the unix epoch
+    /// @param end The latest time to include, in milliseconds since the unix epoch
+    /// @return The plays, ordered from oldest to newest
+    METACORE_EXPORT std::span<Play const> GetPlays(int64_t start, int64_t end);
+    /// @brief Gets the most recent plays of a beatmap
+    /// @param beatmap The serialized beatmap key
+    /// @param count The maximum number of plays to return
+    /// @return The plays, ordered from newest to oldest
+    METACORE_EXPORT std::vector<Play> GetLastPlays(std::string const& beatmap, int count);
+    /// @brief Gets the plays of a beatmap that improved on the best accuracy of all previous plays of the beatmap
+    /// @param beatmap The serialized beatmap key
+    /// @param finishedOnly If quit and failed plays should be left out, as their accuracy only covers the notes played
+    /// @return The plays, ordered from oldest to newest
+    METACORE_EXPORT std::vector<Play> GetBestAccuracyTrend(std::string const& beatmap, bool finishedOnly = true);
+    /// @brief Gets the average accuracy of all plays that ended after a certain time
+    /// @param since The earliest time to include, in milliseconds since the unix epoch
+    /// @param finishedOnly If quit and failed plays should be left out, as their accuracy only covers the notes played
+    /// @return The average accuracy, or 0 if there are no plays
+    METACORE_EXPORT float GetAverageAccuracy(int64_t since, bool finishedOnly = true);
+    /// @brief Gets the average accuracy of the plays of a beatmap that ended after a certain time
+    /// @param beatmap The serialized beatmap key
+    /// @param since The earliest time to include, in milliseconds since the unix epoch
+    /// @param finishedOnly If quit and failed plays should be left out, as their accuracy only covers the notes played
+    /// @return The average accuracy, or 0 if there are no plays
+    METACORE_EXPORT float GetAverageAccuracy(std::string const& beatmap, int64_t since, bool finishedOnly = true);
+}
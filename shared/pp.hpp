@@ -1,8 +1,11 @@
 #pragma once
 
+#include <tuple>
+
 #include "GlobalNamespace/BeatmapKey.hpp"
 #include "GlobalNamespace/GameplayModifiers.hpp"
 #include "export.h"
+#include "ppmath.hpp"
 #include "rapidjson-macros/shared/macros.hpp"
 
 namespace MetaCore::PP {
@@ -41,22 +44,16 @@ namespace MetaCore::PP {
     /// @brief ScoreSaber ranking information for a specific characteristic/difficulty of a map (just a star rating)
     using SSSongDiff = float;
 
-    /// @brief The acc to PP calculation cure for BeatLeader
-    METACORE_EXPORT extern std::vector<std::pair<double, double>> const BeatLeaderCurve;
-    /// @brief The acc to PP calculation cure for ScoreSaber
-    METACORE_EXPORT extern std::vector<std::pair<double, double>> const ScoreSaberCurve;
-
     /// @brief Maps gameplay modifiers to their BeatLeader two-letter string representations
     /// @param modifiers The gameplay modifiers class instance
     /// @param speeds If speed-changing modifiers should be included
     /// @param failed If No Fail should be included, if enabled at all
     /// @return A consistently ordered vector of the lowercase representations of the modifiers
     METACORE_EXPORT std::vector<std::string> GetModStringsBL(GlobalNamespace::GameplayModifiers* modifiers, bool speeds, bool failed);
-    /// @brief Calculates the curve value for a given accuracy
-    /// @param accuracy The accuracy value from 0 to 1
-    /// @param curve BeatLeaderCurve or ScoreSaberCurve
-    /// @return The value of the curve at the given accuracy, interpolated if there is not an exact point in the curve
-    METACORE_EXPORT float AccCurve(float accuracy, std::vector<std::pair<double, double>> const& curve);
+    /// @brief Encodes gameplay modifiers as a mask of PP::Modifier bits, for storing or comparing them cheaply
+    /// @param modifiers The gameplay modifiers class instance
+    /// @return The mask of enabled modifiers, including speed-changing modifiers and No Fail
+    METACORE_EXPORT uint32_t GetModifierMask(GlobalNamespace::GameplayModifiers* modifiers);
 
     /// @brief Checks if a BeatLeader map characteristic/difficulty is ranked
     /// @param map The BeatLeader ranking information
@@ -67,6 +64,13 @@ namespace MetaCore::PP {
     /// @return If the map characteristic/difficulty is ranked
     METACORE_EXPORT bool IsRanked(SSSongDiff const& map);
 
+    /// @brief Applies modifiers to the ratings of a BeatLeader map, for use with CalculateBL and RequiredAccuracyBL
+    /// @param map The BeatLeader ranking information
+    /// @param modifiers The current gameplay modifiers, from GetModifierMask
+    /// @param failed If the player's health has reached 0, so that No Fail is applied if enabled
+    /// @return The modified pass, acc, and tech ratings
+    METACORE_EXPORT std::tuple<float, float, float> GetRatings(BLSongDiff const& map, uint32_t modifiers, bool failed = false);
+
     /// @brief Calculates the BeatLeader PP value for a given accuracy, map, and modifiers
     /// @param map The BeatLeader ranking information
     /// @param accuracy The accuracy value from 0 to 1
@@ -81,6 +85,60 @@ namespace MetaCore::PP {
     /// @param failed If the player's health has reached 0, with or without No Fail
     /// @return The exact PP value
     METACORE_EXPORT float Calculate(SSSongDiff const& map, float accuracy, GlobalNamespace::GameplayModifiers* modifiers, bool failed);
+    /// @brief Calculates the BeatLeader PP value for a given accuracy, map, and modifiers, without any allocations
+    /// @param map The BeatLeader ranking information
+    /// @param accuracy The accuracy value from 0 to 1
+    /// @param modifiers The current gameplay modifiers, from GetModifierMask
+    /// @param failed If the player's health has reached 0, with or without No Fail
+    /// @return The exact PP value
+    METACORE_EXPORT float Calculate(BLSongDiff const& map, float accuracy, uint32_t modifiers, bool failed);
+    /// @brief Calculates the BeatLeader PP values for many accuracies on the same map, with the same results as the single version
+    /// @param map The BeatLeader ranking information
+    /// @param accuracies The accuracy values from 0 to 1
+    /// @param results The output for the PP values, at the same indices as the accuracies (extra elements of either span are ignored)
+    /// @param modifiers The current gameplay modifiers
+    /// @param failed If the player's health has reached 0, with or without No Fail
+    METACORE_EXPORT void Calculate(
+        BLSongDiff const& map, std::span<float const> accuracies, std::span<float> results, GlobalNamespace::GameplayModifiers* modifiers, bool failed
+    );
+    /// @brief Calculates the ScoreSaber PP values for many accuracies on the same map, with the same results as the single version
+    /// @param map The ScoreSaber ranking information
+    /// @param accuracies The accuracy values from 0 to 1
+    /// @param results The output for the PP values, at the same indices as the accuracies (extra elements of either span are ignored)
+    /// @param modifiers The current gameplay modifiers
+    /// @param failed If the player's health has reached 0, with or without No Fail
+    METACORE_EXPORT void Calculate(
+        SSSongDiff const& map, std::span<float const> accuracies, std::span<float> results, GlobalNamespace::GameplayModifiers* modifiers, bool failed
+    );
+
+    /// @brief Finds the lowest accuracy that gives at least a certain BeatLeader PP value for a map and modifiers, without failing
+    /// @param map The BeatLeader ranking information
+    /// @param targetPP The PP value to reach
+    /// @param modifiers The current gameplay modifiers
+    /// @return The accuracy value from 0 to 1, or -1 if the PP value can't be reached
+    METACORE_EXPORT float RequiredAccuracy(BLSongDiff const& map, float targetPP, GlobalNamespace::GameplayModifiers* modifiers);
+    /// @brief Finds the lowest accuracy that gives at least a certain ScoreSaber PP value for a map and modifiers, without failing
+    /// @param map The ScoreSaber ranking information
+    /// @param targetPP The PP value to reach
+    /// @param modifiers The current gameplay modifiers
+    /// @return The accuracy value from 0 to 1, or -1 if the PP value can't be reached
+    METACORE_EXPORT float RequiredAccuracy(SSSongDiff const& map, float targetPP, GlobalNamespace::GameplayModifiers* modifiers);
+    /// @brief Finds the lowest accuracies that give at least certain BeatLeader PP values for a map and modifiers, without failing
+    /// @param map The BeatLeader ranking information
+    /// @param targetPPs The PP values to reach
+    /// @param results The output for the accuracies, or -1 for unreachable values (extra elements of either span are ignored)
+    /// @param modifiers The current gameplay modifiers
+    METACORE_EXPORT void RequiredAccuracy(
+        BLSongDiff const& map, std::span<float const> targetPPs, std::span<float> results, GlobalNamespace::GameplayModifiers* modifiers
+    );
+    /// @brief Finds the lowest accuracies that give at least certain ScoreSaber PP values for a map and modifiers, without failing
+    /// @param map The ScoreSaber ranking information
+    /// @param targetPPs The PP values to reach
+    /// @param results The output for the accuracies, or -1 for unreachable values (extra elements of either span are ignored)
+    /// @param modifiers The current gameplay modifiers
+    METACORE_EXPORT void RequiredAccuracy(
+        SSSongDiff const& map, std::span<float const> targetPPs, std::span<float> results, GlobalNamespace::GameplayModifiers* modifiers
+    );
 
     /// @brief Finds the BeatLeader and ScoreSaber ranking information for a given map characteristic/difficulty
     /// @param map The map characteristic/difficulty to query
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "export.h"
+
+namespace MetaCore::PP {
+    /// @brief Bits for each modifier in a modifier mask, in the same order as GetModStringsBL
+    enum Modifier : uint32_t {
+        DisappearingArrows = 1 << 0,
+        FasterSong = 1 << 1,
+        SlowerSong = 1 << 2,
+        SuperFastSong = 1 << 3,
+        GhostNotes = 1 << 4,
+        NoArrows = 1 << 5,
+        NoBombs = 1 << 6,
+        NoFail = 1 << 7,
+        NoObstacles = 1 << 8,
+        ProMode = 1 << 9,
+        SmallCubes = 1 << 10,
+        InstaFail = 1 << 11,
+        BatteryEnergy = 1 << 12,
+        StrictAngles = 1 << 13,
+        ZenMode = 1 << 14,
+    };
+    /// @brief The number of bits used by modifier masks
+    constexpr int ModifierCount = 15;
+    /// @brief The BeatLeader two-letter representation of each modifier, indexed by bit
+    constexpr std::array<char const*, ModifierCount> ModifierCodes = {
+        "da", "fs", "ss", "sf", "gn", "na", "nb", "nf", "no", "pm", "sc", "if", "be", "sa", "zm",
+    };
+
+    /// @brief A point on an accuracy curve, as the accuracy and the value of the curve at that accuracy
+    using CurvePoint = std::pair<double, double>;
+
+    /// @brief The number of equal accuracy ranges that curve segments are precomputed for
+    constexpr int CurveBuckets = 1024;
+
+    /// @brief Finds the first curve segment that could contain any accuracy in each range, for use with EvaluateCurve
+    /// @param points The curve points, sorted from highest to lowest accuracy, with at least two points
+    /// @param segments The array to fill, with CurveBuckets + 1 elements
+    constexpr void BuildCurveSegments(std::span<CurvePoint const> points, std::span<uint16_t> segments) {
+        int segment = 1;
+        // segments are found from the highest accuracy down, so the search never needs to restart
+        for (int bucket = CurveBuckets; bucket >= 0; bucket--) {
+            double const upper = (bucket + 1) / (double) CurveBuckets;
+            while (segment < points.size() - 1 && points[segment].first > upper)
+                segment++;
+            segments[bucket] = segment;
+        }
+    }
+
+    /// @brief Calculates the value of a curve at an accuracy, with the same result as searching every point of the curve
+    /// @param points The curve points, sorted from highest to lowest accuracy, with at least two points
+    /// @param segments The segments from BuildCurveSegments for the points
+    /// @param accuracy The accuracy value from 0 to 1
+    /// @return The value of the curve at the given accuracy, interpolated if there is not an exact point in the curve
+    constexpr float EvaluateCurve(std::span<CurvePoint const> points, std::span<uint16_t const> segments, float accuracy) {
+        // multiplying by a power of two is exact, so the range is never past the one the accuracy is in
+        int bucket = 0;
+        if (accuracy >= 1)
+            bucket = CurveBuckets;
+        else if (accuracy > 0)
+            bucket = accuracy * CurveBuckets;
+        // only as many steps as there are points in the range, at most two for the built in curves
+        int i = segments[bucket];
+        while (i < points.size() - 1 && points[i].first > accuracy)
+            i++;
+        double const middle_dis = (accuracy - points[i - 1].first) / (points[i].first - points[i - 1].first);
+        return points[i - 1].second + middle_dis * (points[i].second - points[i - 1].second);
+    }
+
+    /// @brief An accuracy curve known at compile time, with its segments precomputed for constant time evaluation
+    /// @tparam N The number of points in the curve
+    template <size_t N>
+    struct CurveTable {
+        std::array<CurvePoint, N> points;
+        std::array<uint16_t, CurveBuckets + 1> segments;
+
+        /// @brief Constructor for a CurveTable
+        /// @param points The curve points, sorted from highest to lowest accuracy, with at least two points
+        constexpr CurveTable(std::array<CurvePoint, N> const& points) : points(points), segments() { BuildCurveSegments(this->points, segments); }
+
+        /// @brief Calculates the curve value for a given accuracy
+        /// @param accuracy The accuracy value from 0 to 1
+        /// @return The value of the curve at the given accuracy, interpolated if there is not an exact point in the curve
+        constexpr float operator()(float accuracy) const { return EvaluateCurve(points, segments, accuracy); }
+    };
+
+    /// @brief An accuracy curve only known at runtime, with the same precomputation as CurveTable
+    struct Curve {
+        std::vector<CurvePoint> points;
+        std::vector<uint16_t> segments;
+
+        /// @brief Constructor for a Curve
+        /// @param points The curve points, sorted from highest to lowest accuracy, with at least two points
+        Curve(std::vector<CurvePoint> points) : points(std::move(points)), segments(CurveBuckets + 1) { BuildCurveSegments(this->points, segments); }
+
+        /// @brief Calculates the curve value for a given accuracy
+        /// @param accuracy The accuracy value from 0 to 1
+        /// @return The value of the curve at the given accuracy, interpolated if there is not an exact point in the curve
+        float operator()(float accuracy) const { return EvaluateCurve(points, segments, accuracy); }
+    };
+
+    /// @brief The acc to PP calculation curve for BeatLeader, evaluated at compile time
+    inline constexpr CurveTable BeatLeaderTable(std::array<CurvePoint, 32>{{
+        {1.0, 7.424},    {0.999, 6.241}, {0.9975, 5.158}, {0.995, 4.010}, {0.9925, 3.241}, {0.99, 2.700}, {0.9875, 2.303}, {0.985, 2.007},
+        {0.9825, 1.786}, {0.98, 1.618},  {0.9775, 1.490}, {0.975, 1.392}, {0.9725, 1.315}, {0.97, 1.256}, {0.965, 1.167},  {0.96, 1.094},
+        {0.955, 1.039},  {0.95, 1.000},  {0.94, 0.931},   {0.93, 0.867},  {0.92, 0.813},   {0.91, 0.768}, {0.9, 0.729},    {0.875, 0.650},
+        {0.85, 0.581},   {0.825, 0.522}, {0.8, 0.473},    {0.75, 0.404},  {0.7, 0.345},    {0.65, 0.296}, {0.6, 0.256},    {0.0, 0.000},
+    }});
+    /// @brief The acc to PP calculation curve for ScoreSaber, evaluated at compile time
+    inline constexpr CurveTable ScoreSaberTable(std::array<CurvePoint, 37>{{
+        {1.0, 5.367394282890631},
+        {0.9995, 5.019543595874787},
+        {0.999, 4.715470646416203},
+        {0.99825, 4.325027383589547},
+        {0.9975, 3.996793606763322},
+        {0.99625, 3.5526145337555373},
+        {0.995, 3.2022017597337955},
+        {0.99375, 2.9190155639254955},
+        {0.9925, 2.685667856592722},
+        {0.99125, 2.4902905794106913},
+        {0.99, 2.324506282149922},
+        {0.9875, 2.058947159052738},
+        {0.985, 1.8563887693647105},
+        {0.9825, 1.697536248647543},
+        {0.98, 1.5702410055532239},
+        {0.9775, 1.4664726399289512},
+        {0.975, 1.3807102743105126},
+        {0.9725, 1.3090333065057616},
+        {0.97, 1.2485807759957321},
+        {0.965, 1.1552120359501035},
+        {0.96, 1.0871883573850478},
+        {0.955, 1.0388633331418984},
+        {0.95, 1.0},
+        {0.94, 0.9417362980580238},
+        {0.93, 0.9039994071865736},
+        {0.92, 0.8728710341448851},
+        {0.91, 0.8488375988124467},
+        {0.9, 0.825756123560842},
+        {0.875, 0.7816934560296046},
+        {0.85, 0.7462290664143185},
+        {0.825, 0.7150465663454271},
+        {0.8, 0.6872268862950283},
+        {0.75, 0.6451808210101443},
+        {0.7, 0.6125565959114954},
+        {0.65, 0.5866010012767576},
+        {0.6, 0.18223233667439062},
+        {0.0, 0.},
+    }});
+
+    /// @brief The acc to PP calculation cure for BeatLeader
+    METACORE_EXPORT extern std::vector<std::pair<double, double>> const BeatLeaderCurve;
+    /// @brief The acc to PP calculation cure for ScoreSaber
+    METACORE_EXPORT extern std::vector<std::pair<double, double>> const ScoreSaberCurve;
+
+    /// @brief Calculates the curve value for a given accuracy
+    /// @param accuracy The accuracy value from 0 to 1
+    /// @param curve Any curve, using the precomputed tables for BeatLeaderCurve and ScoreSaberCurve (prefer Curve for other repeatedly used curves)
+    /// @return The value of the curve at the given accuracy, interpolated if there is not an exact point in the curve
+    METACORE_EXPORT float AccCurve(float accuracy, std::vector<std::pair<double, double>> const& curve);
+
+    /// @brief Calculates the BeatLeader PP value for a given accuracy and ratings, with any modifiers already applied to the ratings
+    /// @param accuracy The accuracy value from 0 to 1
+    /// @param passRating The pass rating of the map
+    /// @param accRating The acc rating of the map
+    /// @param techRating The tech rating of the map
+    /// @return The exact PP value
+    METACORE_EXPORT float CalculateBL(float accuracy, float passRating, float accRating, float techRating);
+    /// @brief Calculates the ScoreSaber PP value for a given accuracy and star rating
+    /// @param accuracy The accuracy value from 0 to 1
+    /// @param stars The star rating of the map
+    /// @param failed If the player's health has reached 0, with or without No Fail
+    /// @return The exact PP value
+    METACORE_EXPORT float CalculateSS(float accuracy, float stars, bool failed);
+
+    /// @brief Calculates the BeatLeader PP values for many accuracies with the same ratings, with any modifiers already applied to the ratings
+    /// @param accuracies The accuracy values from 0 to 1
+    /// @param results The output for the PP values, at the same indices as the accuracies (extra elements of either span are ignored)
+    /// @param passRating The pass rating of the map
+    /// @param accRating The acc rating of the map
+    /// @param techRating The tech rating of the map
+    METACORE_EXPORT void CalculateBL(std::span<float const> accuracies, std::span<float> results, float passRating, float accRating, float techRating);
+    /// @brief Calculates the ScoreSaber PP values for many accuracies with the same star rating
+    /// @param accuracies The accuracy values from 0 to 1
+    /// @param results The output for the PP values, at the same indices as the accuracies (extra elements of either span are ignored)
+    /// @param stars The star rating of the map
+    /// @param failed If the player's health has reached 0, with or without No Fail
+    METACORE_EXPORT void CalculateSS(std::span<float const> accuracies, std::span<float> results, float stars, bool failed);
+
+    /// @brief Finds the lowest accuracy that gives at least a certain BeatLeader PP value, with any modifiers already applied to the ratings
+    /// @param targetPP The PP value to reach
+    /// @param passRating The pass rating of the map
+    /// @param accRating The acc rating of the map
+    /// @param techRating The tech rating of the map
+    /// @return The accuracy value from 0 to 1, or -1 if the PP value can't be reached
+    METACORE_EXPORT float RequiredAccuracyBL(float targetPP, float passRating, float accRating, float techRating);
+    /// @brief Finds the lowest accuracy that gives at least a certain ScoreSaber PP value, without failing
+    /// @param targetPP The PP value to reach
+    /// @param stars The star rating of the map
+    /// @return The accuracy value from 0 to 1, or -1 if the PP value can't be reached
+    METACORE_EXPORT float RequiredAccuracySS(float targetPP, float stars);
+    /// @brief Finds the lowest accuracies that give at least certain BeatLeader PP values, with any modifiers already applied to the ratings
+    /// @param targetPPs The PP values to reach
+    /// @param results The output for the accuracies, at the same indices as the PP values (extra elements of either span are ignored)
+    /// @param passRating The pass rating of the map
+    /// @param accRating The acc rating of the map
+    /// @param techRating The tech rating of the map
+    METACORE_EXPORT void RequiredAccuracyBL(std::span<float const> targetPPs, std::span<float> results, float passRating, float accRating, float techRating);
+    /// @brief Finds the lowest accuracies that give at least certain ScoreSaber PP values, without failing
+    /// @param targetPPs The PP values to reach
+    /// @param results The output for the accuracies, at the same indices as the PP values (extra elements of either span are ignored)
+    /// @param stars The star rating of the map
+    METACORE_EXPORT void RequiredAccuracySS(std::span<float const> targetPPs, std::span<float> results, float stars);
+}
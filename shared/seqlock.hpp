@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace MetaCore {
+    // publishes copies of a value from a single writer thread to any number of reader threads without locks
+    // readers retry if they overlap with a write, so they always get a consistent copy
+    template <class T>
+    struct SeqLock {
+        static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(uint32_t) == 0, "seqlock values must be copyable as 4 byte words");
+        static constexpr int Words = sizeof(T) / sizeof(uint32_t);
+
+        void Write(T const& value) {
+            std::array<uint32_t, Words> words;
+            std::memcpy(words.data(), &value, sizeof(T));
+            uint32_t start = sequence.load(std::memory_order_relaxed);
+            // odd while writing
+            sequence.store(start + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (int i = 0; i < Words; i++)
+                data[i].store(words[i], std::memory_order_relaxed);
+            sequence.store(start + 2, std::memory_order_release);
+        }
+
+        T Read() const {
+            std::array<uint32_t, Words> words;
+            uint32_t before, after;
+            do {
+                before = sequence.load(std::memory_order_acquire);
+                if (before & 1)
+                    continue;
+                for (int i = 0; i < Words; i++)
+                    words[i] = data[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = sequence.load(std::memory_order_relaxed);
+            } while ((before & 1) || before != after);
+            T ret;
+            std::memcpy(&ret, words.data(), sizeof(T));
+            return ret;
+        }
+
+        // the number of completed writes
+        uint32_t Count() const { return sequence.load(std::memory_order_acquire) / 2; }
+
+       private:
+        std::atomic<uint32_t> sequence = 0;
+        std::array<std::atomic<uint32_t>, Words> data = {};
+    };
+}
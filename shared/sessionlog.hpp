@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "export.h"
+
+// session logs are written on a background thread, so logging a play only costs copying each record into memory
+
+namespace MetaCore::SessionLog {
+    enum class RecordType : uint8_t {
+        Start,
+        Cut,
+        BadCut,
+        Miss,
+        Bomb,
+        Wall,
+        Energy,
+        Pause,
+        Unpause,
+        End,
+    };
+
+    /// @brief A single logged event and the state of the play when it happened
+    struct Record {
+        /// @brief The song time of the event, in seconds
+        float songTime;
+        RecordType type;
+        /// @brief The saber involved in the event, matching the constants in stats.hpp
+        int8_t saber;
+        /// @brief The pre swing, post swing, and accuracy scores, for good cuts only
+        uint8_t beforeCutScore;
+        uint8_t afterCutScore;
+        uint8_t centerCutScore;
+        uint8_t multiplier;
+        uint16_t reserved;
+        int32_t combo;
+        /// @brief The total score when the event was logged, without modifiers
+        int32_t score;
+        float health;
+        /// @brief The distance from the center of the note, for cuts only
+        float cutDistance;
+        /// @brief The difference between the times of the cut and the note, for cuts only
+        float timeDeviation;
+    };
+    static_assert(sizeof(Record) == 32, "session log records should stay small and fixed size");
+
+    /// @brief Enables or disables writing a session log for every play, from map start until it ends, restarts, or is quit
+    /// @param enabled If plays should be logged
+    /// @param directory The directory to write the logs to, named by the time they were started
+    METACORE_EXPORT void SetEnabled(bool enabled, std::string directory = "");
+    /// @brief Gets if the current play is being logged
+    /// @return If a session log is being written
+    METACORE_EXPORT bool IsLogging();
+
+    /// @brief Reads the records of a session log, using its index to skip records outside of the requested time range
+    /// @param path The path of the session log file
+    /// @param start The earliest song time to include, in seconds
+    /// @param end The latest song time to include, in seconds
+    /// @param beatmap Set to the serialized beatmap key of the logged play, if not null
+    /// @return The records in the order they were logged, or an empty vector if the file could not be read
+    METACORE_EXPORT std::vector<Record> Read(
+        std::string path, float start = 0, float end = std::numeric_limits<float>::infinity(), std::string* beatmap = nullptr
+    );
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "export.h"
+#include "seqlock.hpp"
+#include "snapshot.hpp"
+
+// the layout and functions here do not depend on the game, so external programs can include this header to read the shared stats
+
+namespace MetaCore::SharedStats {
+    constexpr uint32_t Magic = 0x5353434d;  // "MCSS"
+    // incremented whenever Layout or Stats::Snapshot change
+    constexpr uint32_t Version = 1;
+
+    /// @brief The contents of the shared stats file
+    struct Layout {
+        // always Magic
+        uint32_t magic;
+        // always Version, readers should not continue if it does not match
+        uint32_t version;
+        // sizeof(Layout), which may be larger than expected in future versions
+        uint32_t size;
+        uint32_t reserved;
+        // the latest snapshot, with a sequence counter incremented with each write
+        SeqLock<Stats::Snapshot> snapshot;
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared stats need address-free atomics");
+
+    /// @brief Starts writing every published stats snapshot to a memory-mapped file, stopping any current export
+    /// @param path The path of the file to create or overwrite
+    /// @return If the file was successfully created and mapped
+    METACORE_EXPORT bool Enable(std::string path);
+    /// @brief Stops writing to the shared stats file, leaving the last snapshot in it
+    METACORE_EXPORT void Disable();
+    /// @brief Gets if stats are currently being exported
+    /// @return If a shared stats file is mapped
+    METACORE_EXPORT bool IsEnabled();
+
+    /// @brief Maps an existing shared stats file for reading, intended for external programs
+    /// @param path The path of the file written by MetaCore
+    /// @return The mapped layout, or nullptr if the file could not be mapped or has a different version
+    METACORE_EXPORT Layout const* Open(std::string path);
+    /// @brief Unmaps a layout returned by Open
+    /// @param layout The mapped layout
+    METACORE_EXPORT void Close(Layout const* layout);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// no game types are used here, so this can also be included by external programs reading the shared stats (see sharedstats.hpp)
+
+namespace MetaCore::Stats {
+    /// @brief A copy of commonly used statistics, published every frame and after every score change
+    struct Snapshot {
+        // the number of snapshots published before this one
+        int sequence;
+        // if a map is being played (Internals::stateValid)
+        int valid;
+        float songTime;
+        float songLength;
+        float songSpeed;
+        float health;
+        int multiplier;
+        int songMaxScore;
+        float modifierMultiplier;
+        int wallsHit;
+        int songNotes;
+        int personalBest;
+        int fails;
+        int restarts;
+        // indexed by LeftSaber, RightSaber, and BothSabers
+        int score[3];
+        int maxScore[3];
+        int combo[3];
+        int highestCombo[3];
+        int notesCut[3];
+        int notesMissed[3];
+        int notesBadCut[3];
+        int bombsHit[3];
+        int notesRemaining[3];
+        float preSwing[3];
+        float postSwing[3];
+        float accuracy[3];
+        float timeDependence[3];
+        float averageSpeed[3];
+    };
+}
@@ -2,6 +2,7 @@
 
 #include "GlobalNamespace/NoteData.hpp"
 #include "export.h"
+#include "snapshot.hpp"
 
 namespace MetaCore::Stats {
     /// @brief Checks if a note is a fake note, such as from noodle extensions
@@ -22,6 +23,8 @@ namespace MetaCore::Stats {
     METACORE_EXPORT int GetScore(int saber);
     METACORE_EXPORT int GetMaxScore(int saber);
     METACORE_EXPORT int GetSongMaxScore();
+    // the max score of all notes with times up to the song time, including multiplier ramp up
+    METACORE_EXPORT int GetSongMaxScoreAtTime(float time);
     METACORE_EXPORT int GetCombo(int saber);
     METACORE_EXPORT int GetHighestCombo(int saber);
     METACORE_EXPORT bool GetFullCombo(int saber);
@@ -51,9 +54,24 @@ namespace MetaCore::Stats {
     METACORE_EXPORT float GetBestSpeed5Secs(int saber);
     METACORE_EXPORT float GetLastSecAngle(int saber);
     METACORE_EXPORT float GetHighestSecAngle(int saber);
+    // over the last seconds of the map, rounded to the nearest slow update
+    METACORE_EXPORT float GetAverageSpeed(int saber, float seconds);
+    METACORE_EXPORT float GetBestSpeed(int saber, float seconds);
+    // in degrees per second
+    METACORE_EXPORT float GetAverageAngle(int saber, float seconds);
+    METACORE_EXPORT float GetHighestAngle(int saber, float seconds);
     METACORE_EXPORT float GetModifierMultiplier(bool positive, bool negative);
     METACORE_EXPORT int GetBestScore();
     METACORE_EXPORT int GetFails();
     METACORE_EXPORT int GetRestarts();
     METACORE_EXPORT int GetFCScore(int saber);
+    // live pp for the current play, available once ranking info is found if the map is ranked
+    METACORE_EXPORT bool HasBLPP();
+    METACORE_EXPORT float GetBLPP();
+    METACORE_EXPORT bool HasSSPP();
+    METACORE_EXPORT float GetSSPP();
+
+    /// @brief Gets a consistent copy of the most recently published statistics, safe to call from any thread
+    /// @return The latest snapshot
+    METACORE_EXPORT Snapshot GetSnapshot();
 }
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <span>
+
+#include "export.h"
+
+// the timeline includes every good cut, bad cut, and miss of counted notes (see Stats::ShouldCountNote), in the order they were finished
+// good cuts are finished when their scores are finalized, so they can be after later notes, but the times are always those of the notes
+// spans are invalidated by the next recorded note or map start, so they should not be kept
+
+namespace MetaCore::Timeline {
+    /// @brief The ways a note in the timeline can be finished
+    enum Kinds {
+        // Cut correctly, with all scores filled in
+        GoodCut,
+        // Cut with the wrong saber, direction, or too early, with the scores left as 0
+        BadCut,
+        // Missed, with the scores and all cut values left as 0
+        Miss,
+    };
+
+    /// @brief Gets the number of notes recorded in the current map
+    /// @return The number of notes, and the size of all spans returned by the other functions
+    METACORE_EXPORT int GetNoteCount();
+
+    /// @brief Gets how the recorded notes were finished
+    /// @return The kinds of the notes, matching the Kinds enum
+    METACORE_EXPORT std::span<int const> GetKinds();
+    /// @brief Gets the song times of the recorded notes
+    /// @return The times of the notes themselves, in seconds
+    METACORE_EXPORT std::span<float const> GetTimes();
+    /// @brief Gets the sabers of the recorded notes
+    /// @return The sabers that cut the notes, or the colors of missed notes, matching the constants in stats.hpp
+    METACORE_EXPORT std::span<int const> GetSabers();
+    /// @brief Gets the pre swing scores of the recorded notes
+    /// @return The pre swing scores
+    METACORE_EXPORT std::span<int const> GetBeforeCutScores();
+    /// @brief Gets the post swing scores of the recorded notes
+    /// @return The post swing scores (30 for good cuts of notes with no post swing, matching the statistics)
+    METACORE_EXPORT std::span<int const> GetAfterCutScores();
+    /// @brief Gets the accuracy scores of the recorded notes
+    /// @return The accuracy scores
+    METACORE_EXPORT std::span<int const> GetCenterCutScores();
+    /// @brief Gets the distances of the recorded cuts from the centers of their notes
+    /// @return The distances from the centers
+    METACORE_EXPORT std::span<float const> GetCutDistances();
+    /// @brief Gets the differences between the times of the recorded cuts and the times of their notes
+    /// @return The timing deviations, in seconds
+    METACORE_EXPORT std::span<float const> GetTimeDeviations();
+    /// @brief Gets the angles of the recorded cuts
+    /// @return The cut angles, in degrees
+    METACORE_EXPORT std::span<float const> GetCutAngles();
+    /// @brief Gets the score multipliers as of the recorded notes
+    /// @return The multipliers, as of when each note was cut or missed rather than when its score was finalized
+    METACORE_EXPORT std::span<int const> GetMultipliers();
+}
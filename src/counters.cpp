@@ -0,0 +1,164 @@
+#include "counters.hpp"
+
+#include "journal.hpp"
+
+using namespace MetaCore;
+
+int Internals::leftScore;
+int Internals::rightScore;
+int Internals::leftMaxScore;
+int Internals::rightMaxScore;
+int Internals::songMaxScore;
+int Internals::leftCombo;
+int Internals::rightCombo;
+int Internals::combo;
+int Internals::highestLeftCombo;
+int Internals::highestRightCombo;
+int Internals::highestCombo;
+int Internals::multiplier;
+int Internals::multiplierProgress;
+float Internals::health;
+float Internals::songTime;
+float Internals::songLength;
+float Internals::songSpeed;
+int Internals::notesLeftCut;
+int Internals::notesRightCut;
+int Internals::notesLeftBadCut;
+int Internals::notesRightBadCut;
+int Internals::notesLeftMissed;
+int Internals::notesRightMissed;
+int Internals::bombsLeftHit;
+int Internals::bombsRightHit;
+int Internals::wallsHit;
+int Internals::uncountedNotesLeftCut;
+int Internals::uncountedNotesRightCut;
+int Internals::remainingNotesLeft;
+int Internals::remainingNotesRight;
+int Internals::songNotesLeft;
+int Internals::songNotesRight;
+int Internals::leftPreSwing;
+int Internals::rightPreSwing;
+int Internals::leftPostSwing;
+int Internals::rightPostSwing;
+int Internals::leftAccuracy;
+int Internals::rightAccuracy;
+float Internals::leftTimeDependence;
+float Internals::rightTimeDependence;
+bool Internals::noFail;
+float Internals::positiveMods;
+float Internals::negativeMods;
+int Internals::personalBest;
+int Internals::fails;
+int Internals::restarts;
+int Internals::leftMissedMaxScore;
+int Internals::rightMissedMaxScore;
+int Internals::leftMissedFixedScore;
+int Internals::rightMissedFixedScore;
+
+Journal::Counters Journal::GetCounters() {
+    Counters ret;
+    ret.leftScore = Internals::leftScore;
+    ret.rightScore = Internals::rightScore;
+    ret.leftMaxScore = Internals::leftMaxScore;
+    ret.rightMaxScore = Internals::rightMaxScore;
+    ret.songMaxScore = Internals::songMaxScore;
+    ret.leftCombo = Internals::leftCombo;
+    ret.rightCombo = Internals::rightCombo;
+    ret.combo = Internals::combo;
+    ret.highestLeftCombo = Internals::highestLeftCombo;
+    ret.highestRightCombo = Internals::highestRightCombo;
+    ret.highestCombo = Internals::highestCombo;
+    ret.multiplier = Internals::multiplier;
+    ret.multiplierProgress = Internals::multiplierProgress;
+    ret.health = Internals::health;
+    ret.songTime = Internals::songTime;
+    ret.songLength = Internals::songLength;
+    ret.songSpeed = Internals::songSpeed;
+    ret.notesLeftCut = Internals::notesLeftCut;
+    ret.notesRightCut = Internals::notesRightCut;
+    ret.notesLeftBadCut = Internals::notesLeftBadCut;
+    ret.notesRightBadCut = Internals::notesRightBadCut;
+    ret.notesLeftMissed = Internals::notesLeftMissed;
+    ret.notesRightMissed = Internals::notesRightMissed;
+    ret.bombsLeftHit = Internals::bombsLeftHit;
+    ret.bombsRightHit = Internals::bombsRightHit;
+    ret.wallsHit = Internals::wallsHit;
+    ret.uncountedNotesLeftCut = Internals::uncountedNotesLeftCut;
+    ret.uncountedNotesRightCut = Internals::uncountedNotesRightCut;
+    ret.remainingNotesLeft = Internals::remainingNotesLeft;
+    ret.remainingNotesRight = Internals::remainingNotesRight;
+    ret.songNotesLeft = Internals::songNotesLeft;
+    ret.songNotesRight = Internals::songNotesRight;
+    ret.leftPreSwing = Internals::leftPreSwing;
+    ret.rightPreSwing = Internals::rightPreSwing;
+    ret.leftPostSwing = Internals::leftPostSwing;
+    ret.rightPostSwing = Internals::rightPostSwing;
+    ret.leftAccuracy = Internals::leftAccuracy;
+    ret.rightAccuracy = Internals::rightAccuracy;
+    ret.leftTimeDependence = Internals::leftTimeDependence;
+    ret.rightTimeDependence = Internals::rightTimeDependence;
+    ret.noFail = Internals::noFail;
+    ret.positiveMods = Internals::positiveMods;
+    ret.negativeMods = Internals::negativeMods;
+    ret.personalBest = Internals::personalBest;
+    ret.fails = Internals::fails;
+    ret.restarts = Internals::restarts;
+    ret.leftMissedMaxScore = Internals::leftMissedMaxScore;
+    ret.rightMissedMaxScore = Internals::rightMissedMaxScore;
+    ret.leftMissedFixedScore = Internals::leftMissedFixedScore;
+    ret.rightMissedFixedScore = Internals::rightMissedFixedScore;
+    return ret;
+}
+
+void Journal::SetCounters(Counters const& counters) {
+    Internals::leftScore = counters.leftScore;
+    Internals::rightScore = counters.rightScore;
+    Internals::leftMaxScore = counters.leftMaxScore;
+    Internals::rightMaxScore = counters.rightMaxScore;
+    Internals::songMaxScore = counters.songMaxScore;
+    Internals::leftCombo = counters.leftCombo;
+    Internals::rightCombo = counters.rightCombo;
+    Internals::combo = counters.combo;
+    Internals::highestLeftCombo = counters.highestLeftCombo;
+    Internals::highestRightCombo = counters.highestRightCombo;
+    Internals::highestCombo = counters.highestCombo;
+    Internals::multiplier = counters.multiplier;
+    Internals::multiplierProgress = counters.multiplierProgress;
+    Internals::health = counters.health;
+    Internals::songTime = counters.songTime;
+    Internals::songLength = counters.songLength;
+    Internals::songSpeed = counters.songSpeed;
+    Internals::notesLeftCut = counters.notesLeftCut;
+    Internals::notesRightCut = counters.notesRightCut;
+    Internals::notesLeftBadCut = counters.notesLeftBadCut;
+    Internals::notesRightBadCut = counters.notesRightBadCut;
+    Internals::notesLeftMissed = counters.notesLeftMissed;
+    Internals::notesRightMissed = counters.notesRightMissed;
+    Internals::bombsLeftHit = counters.bombsLeftHit;
+    Internals::bombsRightHit = counters.bombsRightHit;
+    Internals::wallsHit = counters.wallsHit;
+    Internals::uncountedNotesLeftCut = counters.uncountedNotesLeftCut;
+    Internals::uncountedNotesRightCut = counters.uncountedNotesRightCut;
+    Internals::remainingNotesLeft = counters.remainingNotesLeft;
+    Internals::remainingNotesRight = counters.remainingNotesRight;
+    Internals::songNotesLeft = counters.songNotesLeft;
+    Internals::songNotesRight = counters.songNotesRight;
+    Internals::leftPreSwing = counters.leftPreSwing;
+    Internals::rightPreSwing = counters.rightPreSwing;
+    Internals::leftPostSwing = counters.leftPostSwing;
+    Internals::rightPostSwing = counters.rightPostSwing;
+    Internals::leftAccuracy = counters.leftAccuracy;
+    Internals::rightAccuracy = counters.rightAccuracy;
+    Internals::leftTimeDependence = counters.leftTimeDependence;
+    Internals::rightTimeDependence = counters.rightTimeDependence;
+    Internals::noFail = counters.noFail != 0;
+    Internals::positiveMods = counters.positiveMods;
+    Internals::negativeMods = counters.negativeMods;
+    Internals::personalBest = counters.personalBest;
+    Internals::fails = counters.fails;
+    Internals::restarts = counters.restarts;
+    Internals::leftMissedMaxScore = counters.leftMissedMaxScore;
+    Internals::rightMissedMaxScore = counters.rightMissedMaxScore;
+    Internals::leftMissedFixedScore = counters.leftMissedFixedScore;
+    Internals::rightMissedFixedScore = counters.rightMissedFixedScore;
+}
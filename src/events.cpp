@@ -1,134 +1,544 @@
 #include "events.hpp"
 
-#include "input.hpp"
+#include <dlfcn.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+
+#include "dispatch.hpp"
 #include "main.hpp"
 #include "maps.hpp"
 
+// the event of each registered callback, or -1 for global callbacks
+static MetaCore::IndexMap<int> registrations = {};
+
+// library names of the mods that registered callbacks, indexed by the owner of each callback
+static std::vector<std::string> owners = {};
+
+static bool profiling = false;
+
+struct Timings {
+    static constexpr int Recent = 256;
+
+    int count = 0;
+    double total = 0;
+    float max = 0;
+    std::array<float, Recent> recent = {};
+
+    void Add(float micros) {
+        recent[count % Recent] = micros;
+        count++;
+        total += micros;
+        max = std::max(max, micros);
+    }
+
+    MetaCore::Events::CallbackStats Get() const {
+        if (count == 0)
+            return {};
+        // p99 of only the most recent timings
+        int size = std::min(count, Recent);
+        auto sorted = recent;
+        int index = (size - 1) * 99 / 100;
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + size);
+        return {count, (float) (total / count), sorted[index], max};
+    }
+};
+
+static std::vector<Timings> eventTimings = {};
+static std::vector<Timings> ownerTimings = {};
+
+static void AddTiming(int event, int owner, float micros) {
+    if (event >= eventTimings.size())
+        eventTimings.resize(event + 1);
+    if (owner >= ownerTimings.size())
+        ownerTimings.resize(owner + 1);
+    eventTimings[event].Add(micros);
+    ownerTimings[owner].Add(micros);
+}
+
+static int FindOwner(void const* address) {
+    std::string name = "unknown";
+    Dl_info info;
+    if (dladdr(address, &info) && info.dli_fname) {
+        name = info.dli_fname;
+        name = name.substr(name.find_last_of('/') + 1);
+        if (name.starts_with("lib"))
+            name = name.substr(3);
+        if (name.ends_with(".so"))
+            name = name.substr(0, name.size() - 3);
+    }
+    auto existing = std::find(owners.begin(), owners.end(), name);
+    if (existing != owners.end())
+        return existing - owners.begin();
+    owners.emplace_back(std::move(name));
+    return owners.size() - 1;
+}
+
+// must be used directly in the exported functions called by other mods
+// only resolved to an owner with FindOwner once the callback is timed, since dladdr is too slow to run for every registration
+#define CALLER_ADDRESS __builtin_return_address(0)
+
+// a list of callbacks that can be safely modified while it is being called, without copying it every broadcast
+template <class... Ts>
+struct CallbackList {
+    struct Slot {
+        int id;
+        void const* caller;
+        // index in owners, or -1 if not resolved yet
+        int owner;
+        bool once;
+        bool removed;
+        std::function<void(Ts...)> callback;
+    };
+
+    void Add(int id, void const* caller, std::function<void(Ts...)> callback, bool once) {
+        // appending to slots while running could reallocate the callback being run
+        auto& list = running > 0 ? added : slots;
+        list.emplace_back(Slot{id, caller, -1, once, false, std::move(callback)});
+        dirty |= running > 0;
+    }
+
+    bool Empty() const { return slots.empty() && added.empty(); }
+
+    void Remove(int id) {
+        if (std::erase_if(added, [id](Slot const& slot) { return slot.id == id; }) > 0)
+            return;
+        for (auto& slot : slots) {
+            if (slot.id != id || slot.removed)
+                continue;
+            // can't destroy the callback yet if it might be the one running
+            slot.removed = true;
+            dirty = true;
+            Flush();
+            return;
+        }
+    }
+
+    // the list itself can be moved by the dispatch table growing during a callback, so it is accessed through get each time
+    // (the slots are still safe to reference, as moving the list keeps the same buffer)
+    template <class Get>
+    static void Call(Get get, int event, Ts... params) {
+        Running guard(get);
+        // anything added while running goes to a separate list, so this size and the slots will not change
+        size_t const count = get().slots.size();
+        for (size_t i = 0; i < count; i++) {
+            auto& list = get();
+            auto& slot = list.slots[i];
+            if (slot.removed)
+                continue;
+            if (slot.once) {
+                slot.removed = true;
+                list.dirty = true;
+                registrations.erase(slot.id);
+            }
+            if (!profiling) [[likely]] {
+                slot.callback(params...);
+                continue;
+            }
+            if (slot.owner < 0)
+                slot.owner = FindOwner(slot.caller);
+            auto start = std::chrono::steady_clock::now();
+            slot.callback(params...);
+            std::chrono::duration<float, std::micro> duration = std::chrono::steady_clock::now() - start;
+            AddTiming(event, slot.owner, duration.count());
+        }
+    }
+
+   private:
+    template <class Get>
+    struct Running {
+        Get& get;
+        Running(Get& get) : get(get) { get().running++; }
+        ~Running() {
+            auto& list = get();
+            list.running--;
+            list.Flush();
+        }
+    };
+
+    // only does work (and allocates, if there are new callbacks) after registrations change
+    void Flush() {
+        if (running > 0 || !dirty)
+            return;
+        std::erase_if(slots, [](Slot const& slot) { return slot.removed; });
+        for (auto& slot : added)
+            slots.emplace_back(std::move(slot));
+        added.clear();
+        dirty = false;
+    }
+
+    std::vector<Slot> slots;
+    std::vector<Slot> added;
+    int running = 0;
+    bool dirty = false;
+};
+
+struct EventCallbacks {
+    CallbackList<> basic;
+    CallbackList<void const*> payload;
+    CallbackList<> coalesced;
+    bool pending = false;
+};
+
 static std::map<std::string, std::map<int, int>> customEvents = {};
-static std::map<int, MetaCore::IndexMap<std::function<void()>>> callbacks = {};
-static MetaCore::IndexMap<std::function<void(int)>> globalCallbacks = {};
+// indexed directly by global event id, grows as custom events are registered
+static std::vector<EventCallbacks> callbacks(MetaCore::Events::EventMax + 1);
+static CallbackList<int> globalCallbacks = {};
+// events broadcast since the last update that have coalesced callbacks, in order
+static std::vector<int> pendingEvents = {};
 
-static MetaCore::IndexMap<std::tuple<bool, int, int>> registrations = {};
+static_assert(std::is_nothrow_move_constructible_v<EventCallbacks>, "dispatch table growth must move lists without copying callbacks");
 
 static int maxEvent = (int) MetaCore::Events::EventMax;
 
+// flat bitset of the events currently being broadcast, indexed by global id
+static std::vector<bool> runningEvents(MetaCore::Events::EventMax + 1);
+
+// the data of the innermost broadcast in progress, for global callbacks
+static void const* currentData = nullptr;
+static size_t currentSize = 0;
+
 struct EventGuard {
-    bool Guard(int newEvent) {
-        if (events.contains(newEvent))
-            return false;
-        events.emplace(newEvent);
-        event = newEvent;
-        return true;
+    EventGuard(int event, void const* data, size_t size) : event(event), data(currentData), size(currentSize) {
+        runningEvents[event] = true;
+        currentData = data;
+        currentSize = size;
     }
     ~EventGuard() {
-        if (event >= 0)
-            events.erase(event);
+        runningEvents[event] = false;
+        currentData = data;
+        currentSize = size;
     }
 
    private:
-    int event = -1;
-    static inline std::set<int> events = {};
+    int event;
+    void const* data;
+    size_t size;
 };
 
+// broadcasts of events that were already being broadcast, waiting for that to finish
+struct DeferredBroadcast {
+    int event;
+    int depth;
+    std::vector<char> data;
+};
+
+static constexpr int MaxDeferDepth = 8;
+
+static std::vector<DeferredBroadcast> deferred = {};
+// how many deferrals deep the broadcast currently being delivered is
+static int deferDepth = 0;
+
 int MetaCore::Events::RegisterEvent(std::string mod, int modEvent) {
-    if (!customEvents.contains(mod))
-        customEvents[mod] = {};
-    else if (customEvents[mod].contains(modEvent))
+    auto& events = customEvents[std::move(mod)];
+    if (!events.emplace(modEvent, maxEvent + 1).second)
         return -1;
-    customEvents[mod][modEvent] = ++maxEvent;
+    callbacks.resize(++maxEvent + 1);
+    runningEvents.resize(maxEvent + 1);
     return maxEvent;
 }
 
-int MetaCore::Events::FindEvent(std::string mod, int modEvent) {
-    if (!customEvents.contains(mod))
+static int FindEventImpl(std::string const& mod, int modEvent) {
+    auto events = customEvents.find(mod);
+    if (events == customEvents.end())
         return -1;
-    if (!customEvents[mod].contains(modEvent))
+    auto event = events->second.find(modEvent);
+    if (event == events->second.end())
         return -1;
-    return customEvents[mod][modEvent];
-}
-
-template <bool Global, class... Ts>
-static int AddCallbackImpl(MetaCore::IndexMap<std::function<void(Ts...)>>& list, std::function<void(Ts...)> callback, bool once, int event) {
-    if (!once)
-        return registrations.push({Global, event, list.push(std::move(callback))});
-
-    int idx = list.push(nullptr);
-    int registered = registrations.push({Global, event, idx});
-    // list should be a safe reference to keep around
-    list[idx] = [&list, idx, registered, callback = std::move(callback)](Ts... params) {
-        callback(params...);
-        // guaranteed to still have this function at idx, since it's being called
-        list.erase(idx);
-        registrations.erase(registered);
-    };
-    return registered;
+    return event->second;
+}
+
+int MetaCore::Events::FindEvent(std::string mod, int modEvent) {
+    return FindEventImpl(mod, modEvent);
+}
+
+std::pair<std::string, int> MetaCore::Events::FindEvent(int event) {
+    if (event <= EventMax || event > maxEvent)
+        return {"", -1};
+    for (auto const& [mod, events] : customEvents) {
+        for (auto const& [modEvent, id] : events) {
+            if (id == event)
+                return {mod, modEvent};
+        }
+    }
+    return {"", -1};
 }
 
-template <bool Global, class... Ts>
-static int AddCallbackImpl(std::function<void(Ts...)> callback, bool once, int event) {
-    if constexpr (Global)
-        return AddCallbackImpl<Global>(globalCallbacks, callback, once, event);
-    else
-        return AddCallbackImpl<Global>(callbacks[event], callback, once, event);
+template <class... Ts>
+static int AddToList(CallbackList<Ts...>& list, int event, void const* caller, std::function<void(Ts...)> callback, bool once) {
+    int id = registrations.push(event);
+    list.Add(id, caller, std::move(callback), once);
+    return id;
 }
 
 int MetaCore::Events::AddCallback(int event, std::function<void()> callback, bool once) {
     if (event < 0 || event > maxEvent)
         return -1;
-    if (!callbacks.contains(event))
-        callbacks[event] = {};
-    return AddCallbackImpl<false>(std::move(callback), once, event);
+    return AddToList(callbacks[event].basic, event, CALLER_ADDRESS, std::move(callback), once);
+}
+
+int MetaCore::Events::AddCallback(int event, std::function<void()> callback, bool once, bool coalesce) {
+    if (event < 0 || event > maxEvent)
+        return -1;
+    auto& list = coalesce ? callbacks[event].coalesced : callbacks[event].basic;
+    return AddToList(list, event, CALLER_ADDRESS, std::move(callback), once);
 }
 
 int MetaCore::Events::AddCallback(std::string mod, int modEvent, std::function<void()> callback, bool once) {
-    return AddCallback(FindEvent(mod, modEvent), std::move(callback), once);
+    int event = FindEventImpl(mod, modEvent);
+    if (event < 0)
+        return -1;
+    return AddToList(callbacks[event].basic, event, CALLER_ADDRESS, std::move(callback), once);
 }
 
 int MetaCore::Events::AddCallback(std::function<void(int)> callback, bool once) {
-    return AddCallbackImpl<true>(std::move(callback), once, -1);
+    return AddToList(globalCallbacks, -1, CALLER_ADDRESS, std::move(callback), once);
+}
+
+int MetaCore::Events::AddPayloadCallback(int event, std::function<void(void const*)> callback, bool once) {
+    if (event < 0 || event > maxEvent)
+        return -1;
+    return AddToList(callbacks[event].payload, event, CALLER_ADDRESS, std::move(callback), once);
 }
 
 void MetaCore::Events::RemoveCallback(int id) {
     if (!registrations.contains(id))
         return;
-    auto const& [global, event, idx] = registrations[id];
-    if (global)
-        globalCallbacks.erase(idx);
-    else if (callbacks.contains(event))
-        callbacks[event].erase(idx);
+    int event = registrations[id];
+    registrations.erase(id);
+    if (event < 0)
+        globalCallbacks.Remove(id);
+    else {
+        callbacks[event].basic.Remove(id);
+        callbacks[event].payload.Remove(id);
+        callbacks[event].coalesced.Remove(id);
+    }
 }
 
-template <class... Ts>
-static inline void SafeCallCallbacks(MetaCore::IndexMap<std::function<void(Ts...)>> const& callbacks, Ts... params) {
-    std::vector<std::function<void(Ts...)>> copies;
-    copies.reserve(callbacks.size());
-    for (auto const& [_, callback] : callbacks)
-        copies.emplace_back(callback);
-    for (auto const& callback : copies)
-        callback(params...);
+static void RunCoalesced() {
+    // taken out before running, so events broadcast again by these callbacks (or a nested call
+    // from a MapEnded or MapRestarted broadcast) only see the new ones, delivered next time instead
+    std::vector<int> events;
+    events.swap(pendingEvents);
+    for (int event : events) {
+        callbacks[event].pending = false;
+        CallbackList<>::Call([event]() -> auto& { return callbacks[event].coalesced; }, event);
+    }
+    // keep the allocation for the next frame if nothing new was queued
+    if (pendingEvents.empty()) {
+        events.clear();
+        pendingEvents.swap(events);
+    }
 }
 
-bool MetaCore::Events::Broadcast(int event) {
-    if (event < 0 || event > maxEvent)
+static bool Defer(int event, void const* data, size_t size) {
+    if (deferDepth >= MaxDeferDepth) {
+        logger.error("Event {} was broadcast recursively more than {} times, dropping it!", event, MaxDeferDepth);
         return false;
+    }
+    auto& entry = deferred.emplace_back(DeferredBroadcast{event, deferDepth + 1, {}});
+    if (data)
+        entry.data.assign((char const*) data, (char const*) data + size);
+    return true;
+}
+
+static bool BroadcastImpl(int event, void const* data, size_t size);
 
-    EventGuard guard;
-    if (!guard.Guard(event)) {
-        logger.error("Event {} was broadcast even though it was already being run!", event);
+static void RunDeferred(int event) {
+    while (true) {
+        auto next = std::find_if(deferred.begin(), deferred.end(), [event](auto const& entry) { return entry.event == event; });
+        if (next == deferred.end())
+            return;
+        auto entry = std::move(*next);
+        deferred.erase(next);
+        int depth = deferDepth;
+        deferDepth = entry.depth;
+        BroadcastImpl(event, entry.data.empty() ? nullptr : entry.data.data(), entry.data.size());
+        deferDepth = depth;
+    }
+}
+
+static bool BroadcastImpl(int event, void const* data, size_t size) {
+    if (event < 0 || event > maxEvent)
         return false;
+
+    // run after the current broadcast of this event instead of recursively
+    if (runningEvents[event])
+        return Defer(event, data, size);
+
+    // deliver coalesced events once per frame, and before the map ends so the last changes aren't lost
+    if (event == MetaCore::Events::Update || event == MetaCore::Events::MapEnded || event == MetaCore::Events::MapRestarted)
+        RunCoalesced();
+
+    {
+        EventGuard guard(event, data, size);
+
+        CallbackList<int>::Call([]() -> auto& { return globalCallbacks; }, event, event);
+        CallbackList<>::Call([event]() -> auto& { return callbacks[event].basic; }, event);
+        if (data)
+            CallbackList<void const*>::Call([event]() -> auto& { return callbacks[event].payload; }, event, data);
+
+        auto& entry = callbacks[event];
+        if (!entry.pending && !entry.coalesced.Empty()) {
+            entry.pending = true;
+            pendingEvents.emplace_back(event);
+        }
     }
 
-    SafeCallCallbacks(globalCallbacks, event);
-    if (callbacks.contains(event))
-        SafeCallCallbacks(callbacks[event]);
+    if (!deferred.empty())
+        RunDeferred(event);
 
     return true;
 }
 
+bool MetaCore::Events::Broadcast(int event) {
+    return BroadcastImpl(event, nullptr, 0);
+}
+
 bool MetaCore::Events::Broadcast(std::string mod, int modEvent) {
-    if (!customEvents.contains(mod))
+    int event = FindEventImpl(mod, modEvent);
+    if (event < 0)
         return false;
-    if (!customEvents[mod].contains(modEvent))
+    return BroadcastImpl(event, nullptr, 0);
+}
+
+bool MetaCore::Events::Broadcast(int event, void const* data, size_t size) {
+    if (!data || size == 0)
+        return BroadcastImpl(event, nullptr, 0);
+    return BroadcastImpl(event, data, size);
+}
+
+// intrusive multi-producer single-consumer queue (Vyukov), so producers never lock
+struct AsyncBroadcast {
+    std::atomic<AsyncBroadcast*> next = nullptr;
+    int event = -1;
+    std::vector<char> data = {};
+};
+
+static AsyncBroadcast asyncStub;
+static std::atomic<AsyncBroadcast*> asyncHead = &asyncStub;
+// only accessed on the main thread
+static AsyncBroadcast* asyncTail = &asyncStub;
+
+static void PushAsync(AsyncBroadcast* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    auto prev = asyncHead.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+static AsyncBroadcast* PopAsync() {
+    auto tail = asyncTail;
+    auto next = tail->next.load(std::memory_order_acquire);
+    if (tail == &asyncStub) {
+        if (!next)
+            return nullptr;
+        asyncTail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        asyncTail = next;
+        return tail;
+    }
+    // a producer is between the exchange and linking, so leave the rest for next time
+    if (tail != asyncHead.load(std::memory_order_acquire))
+        return nullptr;
+    PushAsync(&asyncStub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        asyncTail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void MetaCore::Events::BroadcastAsync(int event) {
+    auto node = new AsyncBroadcast();
+    node->event = event;
+    PushAsync(node);
+}
+
+void MetaCore::Events::BroadcastAsync(int event, void const* data, size_t size) {
+    auto node = new AsyncBroadcast();
+    node->event = event;
+    if (data && size > 0)
+        node->data.assign((char const*) data, (char const*) data + size);
+    PushAsync(node);
+}
+
+void MetaCore::Events::RunAsyncBroadcasts() {
+    while (auto node = PopAsync()) {
+        std::unique_ptr<AsyncBroadcast> owned(node);
+        if (owned->data.empty())
+            Broadcast(owned->event);
+        else
+            Broadcast(owned->event, owned->data.data(), owned->data.size());
+    }
+}
+
+std::pair<void const*, size_t> MetaCore::Events::CurrentPayload() {
+    return {currentData, currentSize};
+}
+
+void MetaCore::Events::SetProfiling(bool enabled) {
+    profiling = enabled;
+}
+
+bool MetaCore::Events::IsProfiling() {
+    return profiling;
+}
+
+void MetaCore::Events::ResetProfiling() {
+    eventTimings.clear();
+    ownerTimings.clear();
+}
+
+MetaCore::Events::CallbackStats MetaCore::Events::GetEventStats(int event) {
+    if (event < 0 || event >= eventTimings.size())
+        return {};
+    return eventTimings[event].Get();
+}
+
+MetaCore::Events::CallbackStats MetaCore::Events::GetModStats(std::string mod) {
+    for (int i = 0; i < ownerTimings.size(); i++) {
+        if (owners[i] == mod)
+            return ownerTimings[i].Get();
+    }
+    return {};
+}
+
+std::map<std::string, MetaCore::Events::CallbackStats> MetaCore::Events::GetAllModStats() {
+    std::map<std::string, CallbackStats> ret;
+    for (int i = 0; i < ownerTimings.size(); i++) {
+        if (ownerTimings[i].count > 0)
+            ret[owners[i]] = ownerTimings[i].Get();
+    }
+    return ret;
+}
+
+static std::string EventName(int event) {
+    auto [mod, modEvent] = MetaCore::Events::FindEvent(event);
+    if (modEvent >= 0)
+        return fmt::format("{}:{}", mod, modEvent);
+    return std::to_string(event);
+}
+
+bool MetaCore::Events::DumpProfiling(std::string path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        logger.error("Failed to open {} for event profiling", path);
         return false;
-    return Broadcast(customEvents[mod][modEvent]);
+    }
+    static auto const write = [](std::ofstream& file, std::string const& type, std::string const& name, CallbackStats const& stats) {
+        file << fmt::format("{},{},{},{:.2f},{:.2f},{:.2f}\n", type, name, stats.count, stats.mean, stats.p99, stats.max);
+    };
+    file << "type,name,count,mean_us,p99_us,max_us\n";
+    for (int i = 0; i < eventTimings.size(); i++) {
+        if (eventTimings[i].count > 0)
+            write(file, "event", EventName(i), eventTimings[i].Get());
+    }
+    for (auto const& [mod, stats] : GetAllModStats())
+        write(file, "mod", mod, stats);
+    return true;
 }
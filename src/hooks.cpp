@@ -1,14 +1,19 @@
 #include "hooks.hpp"
 
+#include <chrono>
+
 #include "GlobalNamespace/AnnotatedBeatmapLevelCollectionsViewController.hpp"
 #include "System/Collections/Generic/IReadOnlyList_1.hpp"
 #include "GlobalNamespace/AudioTimeSyncController.hpp"
+#include "GlobalNamespace/BeatmapCallbacksUpdater.hpp"
 #include "GlobalNamespace/BeatmapObjectExecutionRatingsRecorder.hpp"
 #include "GlobalNamespace/BeatmapObjectManager.hpp"
+#include "GlobalNamespace/ComboController.hpp"
 #include "GlobalNamespace/CutScoreBuffer.hpp"
 #include "GlobalNamespace/FadeInOutController.hpp"
 #include "GlobalNamespace/GameEnergyCounter.hpp"
 #include "GlobalNamespace/GameScenesManager.hpp"
+#include "GlobalNamespace/GameplayCoreInstaller.hpp"
 #include "GlobalNamespace/LevelCompletionResults.hpp"
 #include "GlobalNamespace/LevelCompletionResultsHelper.hpp"
 #include "GlobalNamespace/MenuTransitionsHelper.hpp"
@@ -24,6 +29,8 @@
 #include "GlobalNamespace/OculusVRHelper.hpp"
 #include "GlobalNamespace/PartyFreePlayFlowCoordinator.hpp"
 #include "GlobalNamespace/PauseMenuManager.hpp"
+#include "GlobalNamespace/PlayerDataModel.hpp"
+#include "GlobalNamespace/SaberManager.hpp"
 #include "GlobalNamespace/ScoreController.hpp"
 #include "GlobalNamespace/ScoreModel.hpp"
 #include "GlobalNamespace/ScoreMultiplierCounter.hpp"
@@ -40,13 +47,21 @@
 #include "VRUIControls/VRGraphicRaycaster.hpp"
 #include "beatsaber-hook/shared/utils/hooking.hpp"
 #include "custom-types/shared/coroutine.hpp"
+#include "cuts.hpp"
 #include "events.hpp"
 #include "game.hpp"
 #include "input.hpp"
 #include "internals.hpp"
 #include "main.hpp"
+#include "payloads.hpp"
+#include "plays.hpp"
+#include "pp.hpp"
+#include "publish.hpp"
+#include "registry.hpp"
+#include "session.hpp"
 #include "songs.hpp"
 #include "stats.hpp"
+#include "timeline.hpp"
 #include "types.hpp"
 #include "unity.hpp"
 
@@ -54,30 +69,85 @@ using namespace GlobalNamespace;
 using namespace MetaCore;
 
 static bool inGameplayScene = false;
+static int pauses = 0;
 
-static std::set<int> pressedButtons;
+static std::array<bool, Input::ButtonsMax + 1> pressedButtons;
 
 static bool IsGameplayScene(UnityW<ScenesTransitionSetupDataSO> scene) {
     return scene && scene.try_cast<LevelScenesTransitionSetupDataSO>();
 }
 
+static float GetPayloadSongTime() {
+    if (Internals::audioTimeSyncController)
+        return Internals::audioTimeSyncController->songTime;
+    return Internals::songTime;
+}
+
+static SessionLog::Record MakeRecord(SessionLog::RecordType type, int saber) {
+    return {
+        .songTime = GetPayloadSongTime(),
+        .type = type,
+        .saber = (int8_t) saber,
+        .multiplier = (uint8_t) Internals::multiplier,
+        .combo = Internals::combo,
+        .score = Internals::leftScore + Internals::rightScore,
+        .health = Internals::health,
+    };
+}
+
+static void LogRecord(SessionLog::RecordType type, int saber) {
+    if (SessionLog::IsLogging())
+        SessionLog::Log(MakeRecord(type, saber));
+}
+
 static void CheckInitialize(UnityW<ScenesTransitionSetupDataSO> scene) {
     if (!IsGameplayScene(scene))
         return;
     logger.debug("gameplay scene start");
     Internals::Initialize();
+    Stats::PublishSnapshot();
+    pauses = 0;
     Events::Broadcast(Events::GameplaySceneStarted);
     inGameplayScene = true;
 }
 
+static void RecordPlay() {
+    if (!Plays::IsOpen())
+        return;
+    int score = Stats::GetScore(Stats::BothSabers);
+    int maxScore = Stats::GetMaxScore(Stats::BothSabers);
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    Plays::Add(
+        (std::string) Internals::beatmapKey.SerializedName(),
+        {
+            .timestamp = millis,
+            .modifiers = Internals::modifiers ? PP::GetModifierMask(Internals::modifiers) : 0,
+            .score = (int) (score * Stats::GetModifierMultiplier(true, true)),
+            .maxScore = maxScore,
+            .accuracy = maxScore > 0 ? score / (float) maxScore : 1,
+            .misses = Stats::GetNotesMissed(Stats::BothSabers) + Stats::GetNotesBadCut(Stats::BothSabers),
+            .pauses = pauses,
+            .duration = Internals::songTime,
+            .songLength = Internals::songLength,
+            .fullCombo = Stats::GetFullCombo(Stats::BothSabers),
+            .quit = Internals::mapWasQuit,
+            .failed = Internals::health <= 0,
+        }
+    );
+}
+
 static void CheckEarlyFinish(LevelCompletionResults::LevelEndAction action) {
     if (!inGameplayScene)
         return;
+    LogRecord(SessionLog::RecordType::End, Stats::BothSabers);
     Internals::Finish(action == LevelCompletionResults::LevelEndAction::Quit, action == LevelCompletionResults::LevelEndAction::Restart);
+    Stats::PublishSnapshot();
     if (Internals::mapWasRestarted)
         Events::Broadcast(Events::MapRestarted);
-    else
+    else {
+        RecordPlay();
         Events::Broadcast(Events::MapEnded);
+    }
 }
 
 static void CheckSceneFinish() {
@@ -104,7 +174,8 @@ MAKE_AUTO_HOOK_MATCH(
     // NoteScoreDefinition fixedCutScore, for now only this case
     bool isGoodScoreFixed = scoringElement->noteData->gameplayType == NoteData::GameplayType::BurstSliderElement;
 
-    if (scoringElement->noteData->colorType == ColorType::ColorA) {
+    bool left = scoringElement->noteData->colorType == ColorType::ColorA;
+    if (left) {
         Internals::leftScore += cutScore;
         Internals::leftMaxScore += maxCutScore;
         if (badCut) {
@@ -125,7 +196,17 @@ MAKE_AUTO_HOOK_MATCH(
         } else
             Internals::rightMissedFixedScore += (scoringElement->cutScore * scoringElement->maxMultiplier) - cutScore;
     }
-    Events::Broadcast(Events::ScoreChanged);
+    // so callbacks reading the snapshot see the new score
+    Stats::PublishSnapshot();
+    Events::Broadcast(Events::ScoreChangedPayload{
+        .saber = left ? Stats::LeftSaber : Stats::RightSaber,
+        .note = scoringElement->noteData,
+        .scoreDelta = cutScore,
+        .maxScoreDelta = maxCutScore,
+        .multiplier = scoringElement->multiplier,
+        .badCut = badCut,
+        .songTime = GetPayloadSongTime(),
+    });
 }
 
 // update combo and good/bad cuts
@@ -176,10 +257,46 @@ MAKE_AUTO_HOOK_MATCH(
                 Internals::notesRightBadCut++;
             Internals::rightCombo = 0;
         }
+        int saber = left ? Stats::LeftSaber : Stats::RightSaber;
+        if (!bomb && Stats::ShouldCountNote(noteController->noteData)) {
+            Timeline::RecordMiss(
+                Timeline::BadCut,
+                noteController->noteData->time,
+                saber,
+                info->cutDistanceToCenter,
+                info->timeDeviation,
+                info->cutAngle,
+                Internals::multiplier
+            );
+        }
+        if (SessionLog::IsLogging()) {
+            auto record = MakeRecord(bomb ? SessionLog::RecordType::Bomb : SessionLog::RecordType::BadCut, saber);
+            record.cutDistance = info->cutDistanceToCenter;
+            record.timeDeviation = info->timeDeviation;
+            SessionLog::Log(record);
+        }
         if (bomb)
-            Events::Broadcast(Events::BombCut);
+            Events::Broadcast(Events::BombCutPayload{
+                .saber = saber,
+                .note = noteController->noteData,
+                .info = *info,
+                .songTime = GetPayloadSongTime(),
+            });
         else
-            Events::Broadcast(Events::NoteCut);
+            Events::Broadcast(Events::NoteCutPayload{
+                .saber = saber,
+                .note = noteController->noteData,
+                .info = *info,
+                .buffer = nullptr,
+                .good = false,
+                .counted = Stats::ShouldCountNote(noteController->noteData),
+                .beforeCutScore = 0,
+                .afterCutScore = 0,
+                .centerCutScore = 0,
+                .cutDistance = info->cutDistanceToCenter,
+                .timeDeviation = info->timeDeviation,
+                .songTime = GetPayloadSongTime(),
+            });
     }
     Events::Broadcast(Events::ComboChanged);
 }
@@ -198,18 +315,29 @@ MAKE_AUTO_HOOK_MATCH(
         return;
 
     Internals::combo = 0;
-    if (noteController->noteData->colorType == ColorType::ColorA) {
+    bool left = noteController->noteData->colorType == ColorType::ColorA;
+    bool counted = Stats::ShouldCountNote(noteController->noteData);
+    if (left) {
         Internals::leftCombo = 0;
         Internals::notesLeftMissed++;
-        if (Stats::ShouldCountNote(noteController->noteData))
+        if (counted)
             Internals::remainingNotesLeft--;
     } else {
         Internals::rightCombo = 0;
         Internals::notesRightMissed++;
-        if (Stats::ShouldCountNote(noteController->noteData))
+        if (counted)
             Internals::remainingNotesRight--;
     }
-    Events::Broadcast(Events::NoteMissed);
+    int saber = left ? Stats::LeftSaber : Stats::RightSaber;
+    if (counted)
+        Timeline::RecordMiss(Timeline::Miss, noteController->noteData->time, saber, 0, 0, 0, Internals::multiplier);
+    LogRecord(SessionLog::RecordType::Miss, saber);
+    Events::Broadcast(Events::NoteMissedPayload{
+        .saber = saber,
+        .note = noteController->noteData,
+        .counted = counted,
+        .songTime = GetPayloadSongTime(),
+    });
     Events::Broadcast(Events::ComboChanged);
 }
 
@@ -217,30 +345,66 @@ MAKE_AUTO_HOOK_MATCH(
 static void HandleCutFinish(CutScoreBuffer* buffer) {
     if (!buffer->noteCutInfo.allIsOK)
         return;
-    if (Stats::ShouldCountNote(buffer->noteCutInfo.noteData)) {
-        int after = buffer->afterCutScore;
+    auto const& info = buffer->noteCutInfo;
+    bool left = info.saberType == SaberType::SaberA;
+    Events::NoteCutPayload payload = {
+        .saber = left ? Stats::LeftSaber : Stats::RightSaber,
+        .note = info.noteData,
+        .info = info,
+        .buffer = buffer,
+        .good = true,
+        .counted = Stats::ShouldCountNote(info.noteData),
+        .beforeCutScore = buffer->beforeCutScore,
+        .afterCutScore = buffer->afterCutScore,
+        .centerCutScore = buffer->centerDistanceCutScore,
+        .cutDistance = info.cutDistanceToCenter,
+        .timeDeviation = info.timeDeviation,
+        .songTime = GetPayloadSongTime(),
+    };
+    if (payload.counted) {
         if (buffer->noteScoreDefinition->maxAfterCutScore == 0)  // TODO: selectively exclude from averages?
-            after = 30;
-        if (buffer->noteCutInfo.saberType == SaberType::SaberA) {
+            payload.afterCutScore = 30;
+        if (left) {
             Internals::notesLeftCut++;
-            Internals::leftPreSwing += buffer->beforeCutScore;
-            Internals::leftPostSwing += after;
-            Internals::leftAccuracy += buffer->centerDistanceCutScore;
-            Internals::leftTimeDependence += std::abs(buffer->noteCutInfo.cutNormal.z);
+            Internals::leftPreSwing += payload.beforeCutScore;
+            Internals::leftPostSwing += payload.afterCutScore;
+            Internals::leftAccuracy += payload.centerCutScore;
+            Internals::leftTimeDependence += std::abs(info.cutNormal.z);
         } else {
             Internals::notesRightCut++;
-            Internals::rightPreSwing += buffer->beforeCutScore;
-            Internals::rightPostSwing += after;
-            Internals::rightAccuracy += buffer->centerDistanceCutScore;
-            Internals::rightTimeDependence += std::abs(buffer->noteCutInfo.cutNormal.z);
+            Internals::rightPreSwing += payload.beforeCutScore;
+            Internals::rightPostSwing += payload.afterCutScore;
+            Internals::rightAccuracy += payload.centerCutScore;
+            Internals::rightTimeDependence += std::abs(info.cutNormal.z);
+        }
+        Timeline::Record(
+            Timeline::GoodCut,
+            info.noteData->time,
+            payload.saber,
+            payload.beforeCutScore,
+            payload.afterCutScore,
+            payload.centerCutScore,
+            payload.cutDistance,
+            payload.timeDeviation,
+            info.cutAngle,
+            buffer->multiplier
+        );
+        if (SessionLog::IsLogging()) {
+            auto record = MakeRecord(SessionLog::RecordType::Cut, payload.saber);
+            record.beforeCutScore = payload.beforeCutScore;
+            record.afterCutScore = payload.afterCutScore;
+            record.centerCutScore = payload.centerCutScore;
+            record.cutDistance = payload.cutDistance;
+            record.timeDeviation = payload.timeDeviation;
+            SessionLog::Log(record);
         }
-        Events::Broadcast(Events::NoteCut);
-    } else if (!Stats::IsFakeNote(buffer->noteCutInfo.noteData)) {
-        if (buffer->noteCutInfo.saberType == SaberType::SaberA)
+        Events::Broadcast(payload);
+    } else if (!Stats::IsFakeNote(info.noteData)) {
+        if (left)
             Internals::uncountedNotesLeftCut++;
         else
             Internals::uncountedNotesRightCut++;
-        Events::Broadcast(Events::NoteCut);
+        Events::Broadcast(payload);
     }
 }
 
@@ -274,6 +438,7 @@ MAKE_AUTO_HOOK_MATCH(
 
     Internals::wallsHit++;
     Internals::combo = 0;
+    LogRecord(SessionLog::RecordType::Wall, Stats::BothSabers);
     Events::Broadcast(Events::WallHit);
     Events::Broadcast(Events::ComboChanged);
 }
@@ -283,15 +448,63 @@ MAKE_AUTO_HOOK_MATCH(
     GameEnergyCounter_ProcessEnergyChange, &GameEnergyCounter::ProcessEnergyChange, void, GameEnergyCounter* self, float energyChange
 ) {
     bool wasAbove0 = !self->_didReach0Energy;
+    float previous = self->energy;
 
     GameEnergyCounter_ProcessEnergyChange(self, energyChange);
 
     if (Internals::noFail && wasAbove0 && self->_didReach0Energy) {
         Internals::negativeMods -= 0.5;
-        Events::Broadcast(Events::ScoreChanged);
+        Stats::PublishSnapshot();
+        Events::Broadcast(Events::ScoreChangedPayload{
+            .saber = Stats::BothSabers,
+            .note = nullptr,
+            .scoreDelta = 0,
+            .maxScoreDelta = 0,
+            .multiplier = Internals::multiplier,
+            .badCut = false,
+            .songTime = GetPayloadSongTime(),
+        });
     }
     Internals::health = self->energy;
-    Events::Broadcast(Events::HealthChanged);
+    if (self->energy != previous)
+        LogRecord(SessionLog::RecordType::Energy, Stats::BothSabers);
+    Events::Broadcast(Events::HealthChangedPayload{
+        .health = self->energy,
+        .change = self->energy - previous,
+        .failed = self->_didReach0Energy,
+        .songTime = GetPayloadSongTime(),
+    });
+}
+
+// register references as they are created, so Internals::Initialize doesn't need to search the scene
+MAKE_AUTO_HOOK_MATCH(ScoreController_ctor, &ScoreController::_ctor, void, ScoreController* self) {
+    ScoreController_ctor(self);
+    Registry::Register(self);
+}
+
+MAKE_AUTO_HOOK_MATCH(ComboController_ctor, &ComboController::_ctor, void, ComboController* self) {
+    ComboController_ctor(self);
+    Registry::Register(self);
+}
+
+MAKE_AUTO_HOOK_MATCH(SaberManager_ctor, &SaberManager::_ctor, void, SaberManager* self) {
+    SaberManager_ctor(self);
+    Registry::Register(self);
+}
+
+MAKE_AUTO_HOOK_MATCH(BeatmapCallbacksUpdater_ctor, &BeatmapCallbacksUpdater::_ctor, void, BeatmapCallbacksUpdater* self) {
+    BeatmapCallbacksUpdater_ctor(self);
+    Registry::Register(self);
+}
+
+MAKE_AUTO_HOOK_MATCH(GameplayCoreInstaller_ctor, &GameplayCoreInstaller::_ctor, void, GameplayCoreInstaller* self) {
+    GameplayCoreInstaller_ctor(self);
+    Registry::Register(self);
+}
+
+MAKE_AUTO_HOOK_MATCH(PlayerDataModel_ctor, &PlayerDataModel::_ctor, void, PlayerDataModel* self) {
+    PlayerDataModel_ctor(self);
+    Registry::Register(self);
 }
 
 // initialize as soon as the scene is loaded
@@ -328,6 +541,7 @@ MAKE_AUTO_HOOK_MATCH(
     Events::Broadcast(Events::MapStarted);
 
     AudioTimeSyncController_StartSong(self, startTimeOffset);
+    LogRecord(SessionLog::RecordType::Start, Stats::BothSabers);
 }
 
 // update song time and run update events
@@ -340,6 +554,7 @@ MAKE_AUTO_HOOK_MATCH(AudioTimeSyncController_Update, &AudioTimeSyncController::U
 
     Internals::DoSlowUpdate();
     Internals::songTime = self->songTime;
+    Stats::PublishSnapshot();
     Events::Broadcast(Events::Update);
 }
 
@@ -347,6 +562,8 @@ MAKE_AUTO_HOOK_MATCH(AudioTimeSyncController_Update, &AudioTimeSyncController::U
 MAKE_AUTO_HOOK_MATCH(PauseMenuManager_ShowMenu, &PauseMenuManager::ShowMenu, void, PauseMenuManager* self) {
 
     PauseMenuManager_ShowMenu(self);
+    pauses++;
+    LogRecord(SessionLog::RecordType::Pause, Stats::BothSabers);
     Events::Broadcast(Events::MapPaused);
 }
 
@@ -355,6 +572,7 @@ MAKE_AUTO_HOOK_MATCH(
     PauseMenuManager_HandleResumeFromPauseAnimationDidFinish, &PauseMenuManager::HandleResumeFromPauseAnimationDidFinish, void, PauseMenuManager* self
 ) {
     PauseMenuManager_HandleResumeFromPauseAnimationDidFinish(self);
+    LogRecord(SessionLog::RecordType::Unpause, Stats::BothSabers);
     Events::Broadcast(Events::MapUnpaused);
 }
 
@@ -366,6 +584,8 @@ MAKE_AUTO_HOOK_MATCH(
     MultiplayerLocalActivePlayerInGameMenuController* self
 ) {
     MultiplayerLocalActivePlayerInGameMenuController_ShowInGameMenu(self);
+    pauses++;
+    LogRecord(SessionLog::RecordType::Pause, Stats::BothSabers);
     Events::Broadcast(Events::MapPaused);
 }
 
@@ -377,6 +597,7 @@ MAKE_AUTO_HOOK_MATCH(
     MultiplayerLocalActivePlayerInGameMenuController* self
 ) {
     MultiplayerLocalActivePlayerInGameMenuController_HideInGameMenu(self);
+    LogRecord(SessionLog::RecordType::Unpause, Stats::BothSabers);
     Events::Broadcast(Events::MapUnpaused);
 }
 
@@ -575,23 +796,41 @@ MAKE_AUTO_HOOK_MATCH(
     AddSignalUpdates(self, Internals::ClearPlaylist, [pack = packs->get_Item(selectedItemIndex)]() { Internals::SetPlaylist(pack); });
 }
 
+struct ButtonEvents {
+    int press;
+    int release;
+    int hold;
+};
+
+// resolved once instead of looking up the strings every frame
+static std::array<ButtonEvents, Input::ButtonsMax + 1> const& GetButtonEvents() {
+    static std::array<ButtonEvents, Input::ButtonsMax + 1> events = []() {
+        std::array<ButtonEvents, Input::ButtonsMax + 1> ret;
+        for (int i = 0; i <= Input::ButtonsMax; i++) {
+            ret[i].press = Events::FindEvent(Input::PressEvents, i);
+            ret[i].release = Events::FindEvent(Input::ReleaseEvents, i);
+            ret[i].hold = Events::FindEvent(Input::HoldEvents, i);
+        }
+        return ret;
+    }();
+    return events;
+}
+
 // run input button events
 MAKE_AUTO_HOOK_MATCH(OVRInput_Update, &OVRInput::Update, void) {
     OVRInput_Update();
 
+    auto const& events = GetButtonEvents();
     for (int i = 0; i <= Input::ButtonsMax; i++) {
         bool pressed = Input::GetPressed(Input::Either, (Input::Buttons) i);
-        bool wasPressed = pressedButtons.contains(i);
-        if (pressed && !wasPressed) {
-            Events::Broadcast(Input::PressEvents, i);
-            pressedButtons.emplace(i);
-        }
+        bool wasPressed = pressedButtons[i];
+        if (pressed && !wasPressed)
+            Events::Broadcast(events[i].press);
         if (pressed)
-            Events::Broadcast(Input::HoldEvents, i);
-        if (!pressed && wasPressed) {
-            Events::Broadcast(Input::ReleaseEvents, i);
-            pressedButtons.erase(i);
-        }
+            Events::Broadcast(events[i].hold);
+        if (!pressed && wasPressed)
+            Events::Broadcast(events[i].release);
+        pressedButtons[i] = pressed;
     }
 }
 
@@ -9,22 +9,30 @@
 #include "GlobalNamespace/GameplayModifiersModelSO.hpp"
 #include "GlobalNamespace/IGameEnergyCounter.hpp"
 #include "GlobalNamespace/ISortedList_1.hpp"
+#include "GlobalNamespace/NoteScoreDefinition.hpp"
 #include "GlobalNamespace/PlayerAllOverallStatsData.hpp"
 #include "GlobalNamespace/PlayerData.hpp"
 #include "GlobalNamespace/PlayerDataModel.hpp"
 #include "GlobalNamespace/PlayerLevelStatsData.hpp"
 #include "GlobalNamespace/Saber.hpp"
 #include "GlobalNamespace/ScoreModel.hpp"
+#include "GlobalNamespace/SliderData.hpp"
 #include "System/Collections/Generic/Dictionary_2.hpp"
+#include "System/Collections/Generic/LinkedListNode_1.hpp"
 #include "System/Collections/Generic/LinkedList_1.hpp"
 #include "System/Collections/IEnumerator.hpp"
 #include "UnityEngine/AudioClip.hpp"
 #include "UnityEngine/Resources.hpp"
 #include "UnityEngine/Time.hpp"
 #include "UnityEngine/Transform.hpp"
+#include "cuts.hpp"
 #include "delegates.hpp"
 #include "events.hpp"
 #include "main.hpp"
+#include "maps.hpp"
+#include "registry.hpp"
+#include "scoring.hpp"
+#include "session.hpp"
 #include "stats.hpp"
 #include "types.hpp"
 #include "unity.hpp"
@@ -36,41 +44,133 @@ using namespace UnityEngine;
 static std::string lastBeatmap;
 static float timeSinceSlowUpdate;
 
-static std::pair<int, int> GetNoteCount(BeatmapCallbacksUpdater* updater, bool left) {
-    using LinkedList = System::Collections::Generic::LinkedList_1<NoteData*>;
+template <class T>
+static System::Collections::Generic::LinkedList_1<T>* GetItems(BeatmapData* data) {
+    return (System::Collections::Generic::LinkedList_1<T>*) data->_beatmapDataItemsPerTypeAndId->GetList(csTypeOf(T), 0)->items;
+}
 
-    if (!updater)
-        return {0, 0};
+template <class T>
+static void ForEachItem(BeatmapData* data, auto&& callback) {
+    auto enumerator = GetItems<T>(data)->GetEnumerator();
+    while (enumerator.MoveNext())
+        callback((T) enumerator.Current);
+}
 
-    int noteCount = 0;
-    int totalCount = 0;
+// everything needed from a single traversal of the beatmap data
+struct BeatmapScan {
+    // cheap checks that the data of a restarted map is the same as when scanned
+    int noteItems = 0;
+    float firstNoteTime = 0;
+    float lastNoteTime = 0;
 
-    auto bcc = updater->_beatmapCallbacksController;
-    auto songTime = bcc->_startFilterTime;
+    // the times of counted notes for each saber, in order
+    std::vector<float> leftNoteTimes;
+    std::vector<float> rightNoteTimes;
+
+    // the time of each scoring element and the total max score up to and including it
+    std::vector<float> maxScoreTimes;
+    std::vector<int> maxScores;
+
+    int GetMaxScore() const { return maxScores.empty() ? 0 : maxScores.back(); }
+
+    static int CountFrom(std::vector<float> const& times, float time) { return times.end() - std::lower_bound(times.begin(), times.end(), time); }
+};
+
+// the level, characteristic, and difficulty of a scanned map
+struct ScanKey {
+    std::string levelId;
+    std::string characteristic;
+    int difficulty;
+
+    auto operator<=>(ScanKey const&) const = default;
+};
+
+static CacheMap<ScanKey, BeatmapScan, 8> scanCache;
+static BeatmapScan uncachedScan;
+static BeatmapScan const* currentScan = nullptr;
+static BeatmapScan const emptyScan;
 
+static bool ScanMatches(BeatmapScan const& scan, BeatmapData* data) {
+    auto notes = GetItems<NoteData*>(data);
+    int count = notes->get_Count();
+    if (count != scan.noteItems)
+        return false;
+    if (count == 0)
+        return true;
+    return ((NoteData*) notes->get_First()->get_Value())->time == scan.firstNoteTime &&
+           ((NoteData*) notes->get_Last()->get_Value())->time == scan.lastNoteTime;
+}
+
+static void ScanBeatmap(BeatmapScan& scan, BeatmapData* data) {
+    // scoring elements matching ScoreModel::ComputeMaxMultipliedScoreForBeatmap
+    std::vector<Scoring::Element> elements;
+
+    scan.noteItems = 0;
+    ForEachItem<NoteData*>(data, [&scan, &elements](NoteData* noteData) {
+        if (scan.noteItems == 0)
+            scan.firstNoteTime = noteData->time;
+        scan.lastNoteTime = noteData->time;
+        scan.noteItems++;
+        if (Stats::ShouldCountNote(noteData)) {
+            if (noteData->colorType == ColorType::ColorA)
+                scan.leftNoteTimes.emplace_back(noteData->time);
+            else
+                scan.rightNoteTimes.emplace_back(noteData->time);
+        }
+        if (noteData->scoringType != NoteData::ScoringType::Ignore && noteData->scoringType != NoteData::ScoringType::NoScore)
+            elements.emplace_back(Scoring::Element{noteData->time, ScoreModel::GetNoteScoreDefinition(noteData->scoringType)->maxCutScore});
+    });
+    int elementScore = ScoreModel::GetNoteScoreDefinition(NoteData::ScoringType::BurstSliderElement)->maxCutScore;
+    ForEachItem<SliderData*>(data, [&elements, elementScore](SliderData* sliderData) {
+        if (sliderData->sliderType != SliderData::Type::Burst)
+            return;
+        for (int i = 1; i < sliderData->sliceCount; i++) {
+            float t = i / (float) (sliderData->sliceCount - 1);
+            elements.emplace_back(Scoring::Element{sliderData->time + (sliderData->tailTime - sliderData->time) * t, elementScore});
+        }
+    });
+    Scoring::ComputeMaxScores(elements, scan.maxScoreTimes, scan.maxScores);
+}
+
+static BeatmapScan const& GetBeatmapScan(BeatmapCallbacksUpdater* updater, GameplayCoreSceneSetupData* setupData) {
+    if (!updater)
+        return emptyScan;
+
+    auto bcc = updater->_beatmapCallbacksController;
     auto data = il2cpp_utils::try_cast<BeatmapData>(bcc->_beatmapData).value_or(nullptr);
     if (!data) {
         logger.warn("IReadonlyBeatmapData was {} not BeatmapData", il2cpp_functions::class_get_name(((Il2CppObject*) bcc->_beatmapData)->klass));
-        return {0, 0};
+        return emptyScan;
     }
 
-    auto noteDataItemsList = (LinkedList*) data->_beatmapDataItemsPerTypeAndId->GetList(csTypeOf(NoteData*), 0)->items;
-    auto enumerator = noteDataItemsList->GetEnumerator();
-    while (enumerator.MoveNext()) {
-        auto noteData = (NoteData*) enumerator.Current;
-        if (Stats::ShouldCountNote(noteData) && (noteData->colorType == ColorType::ColorA) == left) {
-            totalCount++;
-            if (noteData->time >= songTime)
-                noteCount++;
+    // skip the traversal entirely when restarting or replaying the same map
+    std::optional<ScanKey> key;
+    if (setupData) {
+        auto beatmap = setupData->beatmapKey;
+        key = ScanKey{beatmap.levelId, beatmap.beatmapCharacteristic->serializedName, (int) beatmap.difficulty};
+        if (scanCache.contains(*key)) {
+            auto& scan = scanCache.at(*key);
+            if (ScanMatches(scan, data))
+                return scan;
         }
     }
-    return {noteCount, totalCount};
-}
-
-static int GetMaxScore(BeatmapCallbacksUpdater* updater) {
-    if (!updater)
-        return 0;
-    return ScoreModel::ComputeMaxMultipliedScoreForBeatmap(updater->_beatmapCallbacksController->_beatmapData);
+    BeatmapScan scan;
+    ScanBeatmap(scan, data);
+
+#ifndef NDEBUG
+    // check the copied scoring rules against the game
+    int expected = ScoreModel::ComputeMaxMultipliedScoreForBeatmap(bcc->_beatmapData);
+    if (scan.GetMaxScore() != expected)
+        logger.warn("Scanned max score {} does not match game max score {}", scan.GetMaxScore(), expected);
+#endif
+
+    // without a key to identify the map, it can't be reused
+    if (!key) {
+        uncachedScan = std::move(scan);
+        return uncachedScan;
+    }
+    scanCache.push(*key, std::move(scan));
+    return scanCache.at(*key);
 }
 
 static float GetSongLength(ScoreController* controller) {
@@ -137,6 +237,10 @@ static float GetHealth(ScoreController* controller) {
 }
 
 static GameplayCoreSceneSetupData* FindSceneSetupData() {
+    if (auto installer = Registry::Get<GameplayCoreInstaller>(false)) {
+        if (installer->_sceneSetupData != nullptr)
+            return installer->_sceneSetupData;
+    }
     auto gameplayCoreInstallers = Resources::FindObjectsOfTypeAll<GameplayCoreInstaller*>();
     for (auto& installer : gameplayCoreInstallers) {
         if (installer->isActiveAndEnabled && installer->_sceneSetupData != nullptr)
@@ -147,60 +251,14 @@ static GameplayCoreSceneSetupData* FindSceneSetupData() {
     return nullptr;
 }
 
-int Internals::leftScore;
-int Internals::rightScore;
-int Internals::leftMaxScore;
-int Internals::rightMaxScore;
-int Internals::songMaxScore;
-int Internals::leftCombo;
-int Internals::rightCombo;
-int Internals::combo;
-int Internals::highestLeftCombo;
-int Internals::highestRightCombo;
-int Internals::highestCombo;
-int Internals::multiplier;
-int Internals::multiplierProgress;
-float Internals::health;
-float Internals::songTime;
-float Internals::songLength;
-float Internals::songSpeed;
-int Internals::notesLeftCut;
-int Internals::notesRightCut;
-int Internals::notesLeftBadCut;
-int Internals::notesRightBadCut;
-int Internals::notesLeftMissed;
-int Internals::notesRightMissed;
-int Internals::bombsLeftHit;
-int Internals::bombsRightHit;
-int Internals::wallsHit;
-int Internals::uncountedNotesLeftCut;
-int Internals::uncountedNotesRightCut;
-int Internals::remainingNotesLeft;
-int Internals::remainingNotesRight;
-int Internals::songNotesLeft;
-int Internals::songNotesRight;
-int Internals::leftPreSwing;
-int Internals::rightPreSwing;
-int Internals::leftPostSwing;
-int Internals::rightPostSwing;
-int Internals::leftAccuracy;
-int Internals::rightAccuracy;
-float Internals::leftTimeDependence;
-float Internals::rightTimeDependence;
 std::vector<float> Internals::leftSpeeds;
 std::vector<float> Internals::rightSpeeds;
 std::vector<float> Internals::leftAngles;
 std::vector<float> Internals::rightAngles;
-bool Internals::noFail;
-float Internals::positiveMods;
-float Internals::negativeMods;
-int Internals::personalBest;
-int Internals::fails;
-int Internals::restarts;
-int Internals::leftMissedMaxScore;
-int Internals::rightMissedMaxScore;
-int Internals::leftMissedFixedScore;
-int Internals::rightMissedFixedScore;
+Internals::SaberHistory Internals::leftSpeedHistory;
+Internals::SaberHistory Internals::rightSpeedHistory;
+Internals::SaberHistory Internals::leftAngleHistory;
+Internals::SaberHistory Internals::rightAngleHistory;
 Quaternion Internals::prevRotLeft;
 Quaternion Internals::prevRotRight;
 
@@ -225,13 +283,13 @@ bool Internals::mapWasQuit = false;
 bool Internals::mapWasRestarted = false;
 
 void Internals::Initialize() {
-    auto beatmapCallbacksUpdater = Object::FindObjectOfType<BeatmapCallbacksUpdater*>(true);
-    auto playerDataModel = Object::FindObjectOfType<PlayerDataModel*>(true);
+    auto beatmapCallbacksUpdater = Registry::Get<BeatmapCallbacksUpdater>();
+    auto playerDataModel = Registry::Get<PlayerDataModel>();
 
     auto setupData = FindSceneSetupData();
 
     // out of order since we use it
-    scoreController = Object::FindObjectOfType<ScoreController*>(true);
+    scoreController = Registry::Get<ScoreController>();
 
     modifiers = scoreController ? scoreController->_gameplayModifiers : nullptr;
 
@@ -244,9 +302,9 @@ void Internals::Initialize() {
     audioTimeSyncController = scoreController ? scoreController->_audioTimeSyncController : nullptr;
     beatmapCallbacksController = beatmapCallbacksUpdater ? beatmapCallbacksUpdater->_beatmapCallbacksController : nullptr;
     beatmapObjectManager = scoreController ? scoreController->_beatmapObjectManager : nullptr;
-    comboController = Object::FindObjectOfType<ComboController*>(true);
+    comboController = Registry::Get<ComboController>();
     gameEnergyCounter = scoreController ? il2cpp_utils::try_cast<GameEnergyCounter>(scoreController->_gameEnergyCounter).value_or(nullptr) : nullptr;
-    saberManager = Object::FindObjectOfType<SaberManager*>(true);
+    saberManager = Registry::Get<SaberManager>();
     mainCamera = Camera::get_main();
 
     referencesValid = setupData && scoreController && beatmapCallbacksUpdater && comboController && gameEnergyCounter && saberManager && mainCamera;
@@ -271,11 +329,19 @@ void Internals::Initialize() {
             multiplierProgress = normalizedProgress * mult * 2;
         }));
 
+    std::string beatmap = "Unknown";
+    if (setupData)
+        beatmap = (std::string) setupData->beatmapKey.SerializedName();
+
+    auto& scan = GetBeatmapScan(beatmapCallbacksUpdater, setupData);
+    currentScan = &scan;
+    float startTime = beatmapCallbacksUpdater ? beatmapCallbacksUpdater->_beatmapCallbacksController->_startFilterTime : 0;
+
     leftScore = 0;
     rightScore = 0;
     leftMaxScore = 0;
     rightMaxScore = 0;
-    songMaxScore = GetMaxScore(beatmapCallbacksUpdater);
+    songMaxScore = scan.GetMaxScore();
     leftCombo = 0;
     rightCombo = 0;
     combo = 0;
@@ -299,12 +365,11 @@ void Internals::Initialize() {
     wallsHit = 0;
     uncountedNotesLeftCut = 0;
     uncountedNotesRightCut = 0;
-    auto pair = GetNoteCount(beatmapCallbacksUpdater, true);
-    remainingNotesLeft = pair.first;
-    songNotesLeft = pair.second;
-    pair = GetNoteCount(beatmapCallbacksUpdater, false);
-    remainingNotesRight = pair.first;
-    songNotesRight = pair.second;
+    remainingNotesLeft = BeatmapScan::CountFrom(scan.leftNoteTimes, startTime);
+    songNotesLeft = scan.leftNoteTimes.size();
+    remainingNotesRight = BeatmapScan::CountFrom(scan.rightNoteTimes, startTime);
+    songNotesRight = scan.rightNoteTimes.size();
+    Timeline::Reset(songNotesLeft + songNotesRight);
     leftPreSwing = 0;
     rightPreSwing = 0;
     leftPostSwing = 0;
@@ -313,10 +378,10 @@ void Internals::Initialize() {
     rightAccuracy = 0;
     leftTimeDependence = 0;
     rightTimeDependence = 0;
-    leftSpeeds = {};
-    rightSpeeds = {};
-    leftAngles = {};
-    rightAngles = {};
+    leftSpeedHistory.clear();
+    rightSpeedHistory.clear();
+    leftAngleHistory.clear();
+    rightAngleHistory.clear();
     noFail = false;
     // GetNegativeMods sets noFail
     positiveMods = GetPositiveMods(scoreController);
@@ -326,9 +391,6 @@ void Internals::Initialize() {
 
     logger.debug("modifiers {} -{}", positiveMods, negativeMods);
 
-    std::string beatmap = "Unknown";
-    if (setupData)
-        beatmap = (std::string) setupData->beatmapKey.SerializedName();
     if (beatmap != lastBeatmap)
         restarts = 0;
     else
@@ -344,6 +406,8 @@ void Internals::Initialize() {
     prevRotLeft = Quaternion::get_identity();
     prevRotRight = Quaternion::get_identity();
 
+    SessionLog::BeginAuto(beatmap);
+
     stateValid = true;
 }
 
@@ -354,15 +418,19 @@ void Internals::DoSlowUpdate() {
     timeSinceSlowUpdate += Time::get_deltaTime();
     if (timeSinceSlowUpdate > 1 / (float) SLOW_UPDATES_PER_SEC) {
         if (saberManager && saberManager->leftSaber && saberManager->rightSaber) {
-            leftSpeeds.emplace_back(saberManager->leftSaber->bladeSpeed);
-            rightSpeeds.emplace_back(saberManager->rightSaber->bladeSpeed);
+            float leftSpeed = saberManager->leftSaber->bladeSpeed;
+            float rightSpeed = saberManager->rightSaber->bladeSpeed;
+            leftSpeedHistory.push(leftSpeed);
+            rightSpeedHistory.push(rightSpeed);
 
             auto rotLeft = saberManager->leftSaber->transform->rotation;
             auto rotRight = saberManager->rightSaber->transform->rotation;
-            // use speeds array as tracker for if prevRots have accurate values
-            if (leftSpeeds.size() > 1) {
-                leftAngles.emplace_back(Quaternion::Angle(rotLeft, prevRotLeft));
-                rightAngles.emplace_back(Quaternion::Angle(rotRight, prevRotRight));
+            // use speeds history as tracker for if prevRots have accurate values
+            if (leftSpeedHistory.count() > 1) {
+                float leftAngle = Quaternion::Angle(rotLeft, prevRotLeft);
+                float rightAngle = Quaternion::Angle(rotRight, prevRotRight);
+                leftAngleHistory.push(leftAngle);
+                rightAngleHistory.push(rightAngle);
             }
             prevRotLeft = rotLeft;
             prevRotRight = rotRight;
@@ -377,6 +445,17 @@ void Internals::Finish(bool quit, bool restart) {
     referencesValid = false;
     mapWasQuit = quit;
     mapWasRestarted = restart;
+    SessionLog::Finish();
+}
+
+int Internals::GetMaxScoreAtTime(float time) {
+    if (!currentScan)
+        return 0;
+    auto& times = currentScan->maxScoreTimes;
+    auto itr = std::upper_bound(times.begin(), times.end(), time);
+    if (itr == times.begin())
+        return 0;
+    return currentScan->maxScores[itr - times.begin() - 1];
 }
 
 BeatmapKey Internals::selectedKey = {};
@@ -0,0 +1,213 @@
+#include "journal.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "dispatch.hpp"
+#include "events.hpp"
+#include "main.hpp"
+
+using namespace MetaCore;
+
+// journal layout:
+//   header: magic, version, sizeof(Counters)
+//   records: uint8 type, then
+//     Event: int32 event, float seconds since start, uint64 mask of changed counter words, the changed words,
+//            uint32 payload size, the payload (empty if the event was broadcast without data)
+//     Define: int32 event, int32 per-mod id, uint16 mod length, mod (before the first use of a custom event)
+
+static constexpr uint32_t Magic = 0x314a434d;  // "MCJ1"
+static constexpr uint32_t Version = 2;
+
+enum class RecordType : uint8_t {
+    Event,
+    Define,
+};
+
+static constexpr int CounterWords = sizeof(Journal::Counters) / sizeof(uint32_t);
+static_assert(sizeof(Journal::Counters) % sizeof(uint32_t) == 0 && CounterWords <= 64, "counters must fit in a 64 bit changed mask");
+
+template <class T>
+static void Write(std::ofstream& file, T const& value) {
+    file.write((char const*) &value, sizeof(T));
+}
+
+template <class T>
+static bool Read(std::ifstream& file, T& value) {
+    return (bool) file.read((char*) &value, sizeof(T));
+}
+
+static std::ofstream recording;
+static Journal::Counters lastCounters;
+static std::chrono::steady_clock::time_point recordingStart;
+static std::vector<bool> definedEvents;
+
+static bool autoRecord = false;
+static std::string autoRecordDirectory;
+static int recordCallback = -1;
+
+static void WriteDefine(int event) {
+    auto [mod, modEvent] = Events::FindEvent(event);
+    if (modEvent < 0)
+        return;
+    Write(recording, RecordType::Define);
+    Write(recording, (int32_t) event);
+    Write(recording, (int32_t) modEvent);
+    Write(recording, (uint16_t) mod.size());
+    recording.write(mod.data(), mod.size());
+}
+
+static void WriteEvent(int event) {
+    if (event > Events::EventMax) {
+        if (event >= definedEvents.size())
+            definedEvents.resize(event + 1);
+        if (!definedEvents[event])
+            WriteDefine(event);
+        definedEvents[event] = true;
+    }
+
+    auto counters = Journal::GetCounters();
+    auto words = (uint32_t const*) &counters;
+    auto lastWords = (uint32_t const*) &lastCounters;
+    uint64_t mask = 0;
+    for (int i = 0; i < CounterWords; i++) {
+        if (words[i] != lastWords[i])
+            mask |= (uint64_t) 1 << i;
+    }
+    lastCounters = counters;
+
+    std::chrono::duration<float> time = std::chrono::steady_clock::now() - recordingStart;
+    Write(recording, RecordType::Event);
+    Write(recording, (int32_t) event);
+    Write(recording, time.count());
+    Write(recording, mask);
+    for (int i = 0; i < CounterWords; i++) {
+        if (mask & ((uint64_t) 1 << i))
+            Write(recording, words[i]);
+    }
+    auto [data, size] = Events::CurrentPayload();
+    Write(recording, (uint32_t) (data ? size : 0));
+    if (data)
+        recording.write((char const*) data, size);
+}
+
+static void OnEvent(int event) {
+    if (autoRecord && event == Events::GameplaySceneStarted) {
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        Journal::StartRecording(fmt::format("{}/{}.mcj", autoRecordDirectory, millis));
+    }
+    if (!recording.is_open())
+        return;
+    WriteEvent(event);
+    if (autoRecord && event == Events::GameplaySceneEnded)
+        Journal::StopRecording();
+}
+
+static void EnsureCallback() {
+    if (recordCallback < 0)
+        recordCallback = Events::AddCallback(OnEvent);
+}
+
+bool Journal::StartRecording(std::string path) {
+    StopRecording();
+    recording.open(path, std::ios::binary | std::ios::trunc);
+    if (!recording.is_open()) {
+        logger.error("Failed to open {} for event journal", path);
+        return false;
+    }
+    logger.info("Recording event journal to {}", path);
+    Write(recording, Magic);
+    Write(recording, Version);
+    Write(recording, (uint32_t) sizeof(Counters));
+    // all counters are written with the first event
+    lastCounters = GetCounters();
+    auto words = (uint32_t*) &lastCounters;
+    for (int i = 0; i < CounterWords; i++)
+        words[i] = ~words[i];
+    recordingStart = std::chrono::steady_clock::now();
+    definedEvents.clear();
+    EnsureCallback();
+    return true;
+}
+
+void Journal::StopRecording() {
+    if (recording.is_open())
+        recording.close();
+}
+
+bool Journal::IsRecording() {
+    return recording.is_open();
+}
+
+void Journal::SetAutoRecord(bool enabled, std::string directory) {
+    autoRecord = enabled;
+    autoRecordDirectory = std::move(directory);
+    if (enabled)
+        EnsureCallback();
+}
+
+int Journal::Replay(std::string path, float speed, std::function<void(Counters const&)> apply) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t magic, version, size;
+    if (!Read(file, magic) || !Read(file, version) || !Read(file, size) || magic != Magic || version != Version || size != sizeof(Counters)) {
+        logger.error("Failed to read event journal {}", path);
+        return -1;
+    }
+
+    // custom event ids depend on registration order, so they are mapped to the ones in this session
+    std::map<int, int> customEvents;
+    Counters counters = {};
+    auto words = (uint32_t*) &counters;
+    std::vector<char> payload;
+    auto start = std::chrono::steady_clock::now();
+    int broadcasts = 0;
+
+    RecordType type;
+    while (Read(file, type)) {
+        if (type == RecordType::Define) {
+            int32_t event, modEvent;
+            uint16_t length;
+            if (!Read(file, event) || !Read(file, modEvent) || !Read(file, length))
+                break;
+            std::string mod(length, '\0');
+            if (!file.read(mod.data(), length))
+                break;
+            int current = Events::FindEvent(mod, modEvent);
+            if (current < 0)
+                current = Events::RegisterEvent(mod, modEvent);
+            customEvents[event] = current;
+            continue;
+        }
+        int32_t event;
+        float time;
+        uint64_t mask;
+        if (!Read(file, event) || !Read(file, time) || !Read(file, mask))
+            break;
+        for (int i = 0; i < CounterWords; i++) {
+            if (mask & ((uint64_t) 1 << i))
+                Read(file, words[i]);
+        }
+        uint32_t size;
+        if (!Read(file, size))
+            break;
+        payload.resize(size);
+        if (!file.read(payload.data(), size))
+            break;
+        if (event > Events::EventMax) {
+            auto current = customEvents.find(event);
+            if (current == customEvents.end())
+                continue;
+            event = current->second;
+        }
+        if (speed > 0)
+            std::this_thread::sleep_until(start + std::chrono::duration<float>(time / speed));
+        if (apply)
+            apply(counters);
+        Events::Broadcast(event, payload.data(), payload.size());
+        broadcasts++;
+    }
+    return broadcasts;
+}
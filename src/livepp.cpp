@@ -0,0 +1,97 @@
+#include "livepp.hpp"
+
+#include "events.hpp"
+#include "internals.hpp"
+#include "main.hpp"
+#include "payloads.hpp"
+#include "pp.hpp"
+#include "stats.hpp"
+
+using namespace MetaCore;
+
+// everything that doesn't depend on the score is found once per play, and the pp values are only
+// recalculated when the score or failed state actually changes (including when checked before the event reaches this)
+
+static int play = 0;
+static LivePP::Ratings ratings;
+
+static bool failed = false;
+static LivePP::Inputs lastInputs;
+static bool calculated = false;
+static float blPP = 0;
+static float ssPP = 0;
+
+static void Update() {
+    if (!ratings.hasBL && !ratings.hasSS)
+        return;
+    LivePP::Inputs inputs = {
+        .score = Stats::GetScore(Stats::BothSabers),
+        .maxScore = Stats::GetMaxScore(Stats::BothSabers),
+        .modifierMultiplier = Stats::GetModifierMultiplier(true, true),
+        .failed = failed,
+        .noFail = Internals::noFail,
+    };
+    if (calculated && inputs == lastInputs)
+        return;
+    lastInputs = inputs;
+    calculated = true;
+    std::tie(blPP, ssPP) = LivePP::Calculate(ratings, inputs);
+}
+
+static void OnSceneStarted() {
+    int current = ++play;
+    ratings = {};
+    failed = false;
+    calculated = false;
+    blPP = 0;
+    ssPP = 0;
+    uint32_t modifiers = Internals::modifiers ? PP::GetModifierMask(Internals::modifiers) : 0;
+
+    PP::GetMapInfo(Internals::beatmapKey, [current, modifiers](std::optional<PP::BLSongDiff> bl, std::optional<PP::SSSongDiff> ss) {
+        // ignore info that arrives after the play has ended
+        if (current != play || !Internals::stateValid)
+            return;
+        ratings.hasBL = bl && PP::IsRanked(*bl);
+        if (ratings.hasBL) {
+            ratings.bl = PP::GetRatings(*bl, modifiers);
+            ratings.blFailed = PP::GetRatings(*bl, modifiers, true);
+        }
+        ratings.hasSS = ss && PP::IsRanked(*ss);
+        if (ratings.hasSS)
+            ratings.stars = *ss;
+        logger.debug("live pp ranked on bl {} ss {}", ratings.hasBL, ratings.hasSS);
+        calculated = false;
+        Update();
+    });
+}
+
+static void OnHealthChanged(Events::HealthChangedPayload const& payload) {
+    if (payload.failed == failed)
+        return;
+    failed = payload.failed;
+    Update();
+}
+
+void Stats::InstallLivePP() {
+    Events::AddCallback(Events::GameplaySceneStarted, OnSceneStarted);
+    Events::AddCallback(Events::ScoreChanged, Update);
+    Events::AddCallback<Events::HealthChangedPayload>(OnHealthChanged);
+}
+
+bool Stats::HasBLPP() {
+    return ratings.hasBL;
+}
+
+float Stats::GetBLPP() {
+    Update();
+    return blPP;
+}
+
+bool Stats::HasSSPP() {
+    return ratings.hasSS;
+}
+
+float Stats::GetSSPP() {
+    Update();
+    return ssPP;
+}
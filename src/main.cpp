@@ -4,6 +4,7 @@
 #include "events.hpp"
 #include "hooks.hpp"
 #include "input.hpp"
+#include "livepp.hpp"
 #include "scotland2/shared/modloader.h"
 #include "types.hpp"
 
@@ -21,6 +22,7 @@ extern "C" METACORE_EXPORT void setup(CModInfo* info) {
     *info = modInfo.to_c();
     Paper::Logger::RegisterFileContextId(MOD_ID);
     RegisterButtonEvents();
+    MetaCore::Stats::InstallLivePP();
     logger.info("Completed setup!");
 }
 
@@ -0,0 +1,281 @@
+#include "plays.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+#include "main.hpp"
+
+using namespace MetaCore;
+
+// history layout, both files are only ever appended to:
+//   plays.mcp: magic, version, sizeof(Play), then plays in order of their timestamps (the time index)
+//   beatmaps.mcp: magic, version, then uint16 length and serialized key for each beatmap, in order of their ids
+// the per-beatmap indices and accuracy sums are rebuilt from the beatmap ids in one pass when loading,
+// which is cheap compared to reading the plays and can't disagree with them after a partial write
+
+static constexpr uint32_t PlaysMagic = 0x5050434d;  // "MCPP"
+static constexpr uint32_t BeatmapsMagic = 0x4250434d;  // "MCPB"
+static constexpr uint32_t Version = 1;
+static constexpr int PlaysHeaderSize = 3 * sizeof(uint32_t);
+
+// running totals of the first i plays are at index i
+struct Totals {
+    double accuracy = 0;
+    double finishedAccuracy = 0;
+    uint32_t finished = 0;
+};
+
+struct BeatmapIndex {
+    // positions in the plays vector
+    std::vector<uint32_t> plays;
+    std::vector<Totals> totals = {{}};
+    std::vector<uint32_t> bestAccuracies;
+    std::vector<uint32_t> bestFinishedAccuracies;
+};
+
+template <class T>
+static void Write(std::ofstream& file, T const& value) {
+    file.write((char const*) &value, sizeof(T));
+}
+
+template <class T>
+static bool Read(std::ifstream& file, T& value) {
+    return (bool) file.read((char*) &value, sizeof(T));
+}
+
+static bool historyOpen = false;
+static std::ofstream playsFile;
+static std::ofstream beatmapsFile;
+
+static std::vector<Plays::Play> plays;
+static std::vector<Totals> totals = {{}};
+static std::vector<std::string> beatmapKeys;
+static std::unordered_map<std::string, uint32_t> beatmapIds;
+static std::vector<BeatmapIndex> beatmapIndices;
+
+static void Clear() {
+    plays.clear();
+    totals = {{}};
+    beatmapKeys.clear();
+    beatmapIds.clear();
+    beatmapIndices.clear();
+}
+
+static uint32_t AddBeatmap(std::string key) {
+    uint32_t id = beatmapKeys.size();
+    beatmapIds[key] = id;
+    beatmapKeys.emplace_back(std::move(key));
+    beatmapIndices.emplace_back();
+    return id;
+}
+
+static void AddTotals(std::vector<Totals>& totals, Plays::Play const& play) {
+    auto next = totals.back();
+    next.accuracy += play.accuracy;
+    if (play.finished()) {
+        next.finishedAccuracy += play.accuracy;
+        next.finished++;
+    }
+    totals.emplace_back(next);
+}
+
+static void AddIfBest(std::vector<uint32_t>& best, uint32_t position) {
+    if (best.empty() || plays[position].accuracy > plays[best.back()].accuracy)
+        best.emplace_back(position);
+}
+
+static void IndexPlay(uint32_t position) {
+    auto const& play = plays[position];
+    AddTotals(totals, play);
+    auto& index = beatmapIndices[play.beatmap];
+    index.plays.emplace_back(position);
+    AddTotals(index.totals, play);
+    AddIfBest(index.bestAccuracies, position);
+    if (play.finished())
+        AddIfBest(index.bestFinishedAccuracies, position);
+}
+
+// the average accuracy of the plays from first to the end of the totals
+static float AverageAccuracy(std::vector<Totals> const& totals, int first, bool finishedOnly) {
+    auto const& start = totals[first];
+    auto const& end = totals.back();
+    int count = finishedOnly ? end.finished - start.finished : totals.size() - 1 - first;
+    if (count == 0)
+        return 0;
+    return (finishedOnly ? end.finishedAccuracy - start.finishedAccuracy : end.accuracy - start.accuracy) / count;
+}
+
+static BeatmapIndex const* FindBeatmap(std::string const& beatmap) {
+    auto id = beatmapIds.find(beatmap);
+    if (id == beatmapIds.end())
+        return nullptr;
+    return &beatmapIndices[id->second];
+}
+
+static bool LoadBeatmaps(std::filesystem::path const& path) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t magic, version;
+    if (!Read(file, magic) || !Read(file, version) || magic != BeatmapsMagic || version != Version)
+        return false;
+    uint16_t length;
+    while (Read(file, length)) {
+        std::string key(length, '\0');
+        if (!file.read(key.data(), length))
+            break;
+        AddBeatmap(std::move(key));
+    }
+    return true;
+}
+
+static bool LoadPlays(std::filesystem::path const& path) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t magic, version, size;
+    if (!Read(file, magic) || !Read(file, version) || !Read(file, size) || magic != PlaysMagic || version != Version || size != sizeof(Plays::Play))
+        return false;
+    auto count = (std::filesystem::file_size(path) - PlaysHeaderSize) / sizeof(Plays::Play);
+    plays.resize(count);
+    file.read((char*) plays.data(), count * sizeof(Plays::Play));
+    plays.resize(file.gcount() / sizeof(Plays::Play));
+    totals.reserve(plays.size() + 1);
+    for (uint32_t i = 0; i < plays.size(); i++) {
+        // a play for a beatmap that wasn't written means the files were cut off
+        if (plays[i].beatmap >= beatmapKeys.size()) {
+            plays.resize(i);
+            break;
+        }
+        IndexPlay(i);
+    }
+    // remove any partially written play so that appending stays aligned
+    std::filesystem::resize_file(path, PlaysHeaderSize + plays.size() * sizeof(Plays::Play));
+    return true;
+}
+
+bool Plays::Open(std::string directory) {
+    Close();
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    auto playsPath = std::filesystem::path(directory) / "plays.mcp";
+    auto beatmapsPath = std::filesystem::path(directory) / "beatmaps.mcp";
+
+    if (!std::filesystem::exists(playsPath) || !std::filesystem::exists(beatmapsPath)) {
+        std::ofstream newPlays(playsPath, std::ios::binary | std::ios::trunc);
+        Write(newPlays, PlaysMagic);
+        Write(newPlays, Version);
+        Write(newPlays, (uint32_t) sizeof(Play));
+        std::ofstream newBeatmaps(beatmapsPath, std::ios::binary | std::ios::trunc);
+        Write(newBeatmaps, BeatmapsMagic);
+        Write(newBeatmaps, Version);
+    } else if (!LoadBeatmaps(beatmapsPath) || !LoadPlays(playsPath)) {
+        logger.error("Failed to read play history in {}", directory);
+        Clear();
+        return false;
+    }
+
+    playsFile.open(playsPath, std::ios::binary | std::ios::app);
+    beatmapsFile.open(beatmapsPath, std::ios::binary | std::ios::app);
+    if (!playsFile.is_open() || !beatmapsFile.is_open()) {
+        logger.error("Failed to open play history in {}", directory);
+        Close();
+        return false;
+    }
+    logger.info("Loaded {} plays of {} beatmaps from {}", plays.size(), beatmapKeys.size(), directory);
+    historyOpen = true;
+    return true;
+}
+
+void Plays::Close() {
+    if (playsFile.is_open())
+        playsFile.close();
+    if (beatmapsFile.is_open())
+        beatmapsFile.close();
+    Clear();
+    historyOpen = false;
+}
+
+bool Plays::IsOpen() {
+    return historyOpen;
+}
+
+void Plays::Add(std::string const& beatmap, Play play) {
+    if (!historyOpen)
+        return;
+
+    auto id = beatmapIds.find(beatmap);
+    if (id != beatmapIds.end())
+        play.beatmap = id->second;
+    else {
+        play.beatmap = AddBeatmap(beatmap);
+        Write(beatmapsFile, (uint16_t) beatmap.size());
+        beatmapsFile.write(beatmap.data(), beatmap.size());
+        beatmapsFile.flush();
+    }
+    // keep the plays sorted even if the clock changes
+    if (!plays.empty())
+        play.timestamp = std::max(play.timestamp, plays.back().timestamp);
+
+    plays.emplace_back(play);
+    IndexPlay(plays.size() - 1);
+    Write(playsFile, play);
+    playsFile.flush();
+}
+
+std::string Plays::GetBeatmap(uint32_t id) {
+    if (id >= beatmapKeys.size())
+        return "";
+    return beatmapKeys[id];
+}
+
+static auto LowerBound(int64_t time) {
+    return std::lower_bound(plays.begin(), plays.end(), time, [](Plays::Play const& play, int64_t time) { return play.timestamp < time; });
+}
+
+std::span<Plays::Play const> Plays::GetPlays() {
+    return plays;
+}
+
+std::span<Plays::Play const> Plays::GetPlays(int64_t start, int64_t end) {
+    auto first = LowerBound(start);
+    auto last = std::upper_bound(first, plays.end(), end, [](int64_t time, Play const& play) { return time < play.timestamp; });
+    return {first, last};
+}
+
+std::vector<Plays::Play> Plays::GetLastPlays(std::string const& beatmap, int count) {
+    std::vector<Play> ret;
+    auto index = FindBeatmap(beatmap);
+    if (!index)
+        return ret;
+    count = std::min(count, (int) index->plays.size());
+    ret.reserve(count);
+    for (int i = 0; i < count; i++)
+        ret.emplace_back(plays[index->plays[index->plays.size() - 1 - i]]);
+    return ret;
+}
+
+std::vector<Plays::Play> Plays::GetBestAccuracyTrend(std::string const& beatmap, bool finishedOnly) {
+    std::vector<Play> ret;
+    auto index = FindBeatmap(beatmap);
+    if (!index)
+        return ret;
+    auto const& best = finishedOnly ? index->bestFinishedAccuracies : index->bestAccuracies;
+    ret.reserve(best.size());
+    for (auto position : best)
+        ret.emplace_back(plays[position]);
+    return ret;
+}
+
+float Plays::GetAverageAccuracy(int64_t since, bool finishedOnly) {
+    return AverageAccuracy(totals, LowerBound(since) - plays.begin(), finishedOnly);
+}
+
+float Plays::GetAverageAccuracy(std::string const& beatmap, int64_t since, bool finishedOnly) {
+    auto index = FindBeatmap(beatmap);
+    if (!index)
+        return 0;
+    auto start = std::lower_bound(index->plays.begin(), index->plays.end(), since, [](uint32_t position, int64_t time) {
+        return plays[position].timestamp < time;
+    });
+    return AverageAccuracy(index->totals, start - index->plays.begin(), finishedOnly);
+}
@@ -57,55 +57,6 @@ struct Request {
 
 static std::map<std::string, Request> requests;
 
-static constexpr double ScoresaberMult = 42.117208413;
-
-std::vector<std::pair<double, double>> const PP::BeatLeaderCurve = {
-    {1.0, 7.424},    {0.999, 6.241}, {0.9975, 5.158}, {0.995, 4.010}, {0.9925, 3.241}, {0.99, 2.700}, {0.9875, 2.303}, {0.985, 2.007},
-    {0.9825, 1.786}, {0.98, 1.618},  {0.9775, 1.490}, {0.975, 1.392}, {0.9725, 1.315}, {0.97, 1.256}, {0.965, 1.167},  {0.96, 1.094},
-    {0.955, 1.039},  {0.95, 1.000},  {0.94, 0.931},   {0.93, 0.867},  {0.92, 0.813},   {0.91, 0.768}, {0.9, 0.729},    {0.875, 0.650},
-    {0.85, 0.581},   {0.825, 0.522}, {0.8, 0.473},    {0.75, 0.404},  {0.7, 0.345},    {0.65, 0.296}, {0.6, 0.256},    {0.0, 0.000},
-};
-
-std::vector<std::pair<double, double>> const PP::ScoreSaberCurve = {
-    {1.0, 5.367394282890631},
-    {0.9995, 5.019543595874787},
-    {0.999, 4.715470646416203},
-    {0.99825, 4.325027383589547},
-    {0.9975, 3.996793606763322},
-    {0.99625, 3.5526145337555373},
-    {0.995, 3.2022017597337955},
-    {0.99375, 2.9190155639254955},
-    {0.9925, 2.685667856592722},
-    {0.99125, 2.4902905794106913},
-    {0.99, 2.324506282149922},
-    {0.9875, 2.058947159052738},
-    {0.985, 1.8563887693647105},
-    {0.9825, 1.697536248647543},
-    {0.98, 1.5702410055532239},
-    {0.9775, 1.4664726399289512},
-    {0.975, 1.3807102743105126},
-    {0.9725, 1.3090333065057616},
-    {0.97, 1.2485807759957321},
-    {0.965, 1.1552120359501035},
-    {0.96, 1.0871883573850478},
-    {0.955, 1.0388633331418984},
-    {0.95, 1.0},
-    {0.94, 0.9417362980580238},
-    {0.93, 0.9039994071865736},
-    {0.92, 0.8728710341448851},
-    {0.91, 0.8488375988124467},
-    {0.9, 0.825756123560842},
-    {0.875, 0.7816934560296046},
-    {0.85, 0.7462290664143185},
-    {0.825, 0.7150465663454271},
-    {0.8, 0.6872268862950283},
-    {0.75, 0.6451808210101443},
-    {0.7, 0.6125565959114954},
-    {0.65, 0.5866010012767576},
-    {0.6, 0.18223233667439062},
-    {0.0, 0.},
-};
-
 std::vector<std::string> PP::GetModStringsBL(GameplayModifiers* modifiers, bool speeds, bool failed) {
     std::vector<std::string> ret;
     if (modifiers->_disappearingArrows)
@@ -141,29 +92,39 @@ std::vector<std::string> PP::GetModStringsBL(GameplayModifiers* modifiers, bool
     return ret;
 }
 
-float PP::AccCurve(float acc, std::vector<std::pair<double, double>> const& curve) {
-    int i = 1;
-    for (; i < curve.size(); i++) {
-        if (curve[i].first <= acc)
-            break;
-    }
-
-    double const middle_dis = (acc - curve[i - 1].first) / (curve[i].first - curve[i - 1].first);
-    return curve[i - 1].second + middle_dis * (curve[i].second - curve[i - 1].second);
-}
-
-static std::tuple<float, float, float> CalculatePP(float accuracy, float accRating, float passRating, float techRating) {
-    float passPP = passRating > 0 ? 15.2 * std::exp(std::pow(passRating, 1 / 2.62)) - 30 : 0;
-    if (passPP < 0)
-        passPP = 0;
-    float const accPP = PP::AccCurve(accuracy, PP::BeatLeaderCurve) * accRating * 34;
-    float const techPP = std::exp(1.9 * accuracy) * 1.08 * techRating;
-
-    return {passPP, accPP, techPP};
-}
-
-static inline float Inflate(float pp) {
-    return 650 * std::pow(pp, 1.3) / std::pow(650, 1.3);
+uint32_t PP::GetModifierMask(GameplayModifiers* modifiers) {
+    uint32_t ret = 0;
+    if (modifiers->_disappearingArrows)
+        ret |= DisappearingArrows;
+    if (modifiers->_songSpeed == GameplayModifiers::SongSpeed::Faster)
+        ret |= FasterSong;
+    if (modifiers->_songSpeed == GameplayModifiers::SongSpeed::Slower)
+        ret |= SlowerSong;
+    if (modifiers->_songSpeed == GameplayModifiers::SongSpeed::SuperFast)
+        ret |= SuperFastSong;
+    if (modifiers->_ghostNotes)
+        ret |= GhostNotes;
+    if (modifiers->_noArrows)
+        ret |= NoArrows;
+    if (modifiers->_noBombs)
+        ret |= NoBombs;
+    if (modifiers->_noFailOn0Energy)
+        ret |= NoFail;
+    if (modifiers->_enabledObstacleType == GameplayModifiers::EnabledObstacleType::NoObstacles)
+        ret |= NoObstacles;
+    if (modifiers->_proMode)
+        ret |= ProMode;
+    if (modifiers->_smallCubes)
+        ret |= SmallCubes;
+    if (modifiers->_instaFail)
+        ret |= InstaFail;
+    if (modifiers->_energyType == GameplayModifiers::EnergyType::Battery)
+        ret |= BatteryEnergy;
+    if (modifiers->_strictAngles)
+        ret |= StrictAngles;
+    if (modifiers->_zenMode)
+        ret |= ZenMode;
+    return ret;
 }
 
 bool PP::IsRanked(PP::BLSongDiff const& map) {
@@ -175,59 +136,97 @@ bool PP::IsRanked(PP::SSSongDiff const& map) {
     return map > 0;
 }
 
-float PP::Calculate(PP::BLSongDiff const& map, float percentage, GameplayModifiers* modifiers, bool failed) {
-    if (failed)
-        return 0;
+std::tuple<float, float, float> PP::GetRatings(BLSongDiff const& map, uint32_t modifiers, bool failed) {
     float passRating = map.Pass;
     float accRating = map.Acc;
     float techRating = map.Tech;
 
-    bool const precalculatedSpeeds = map.ModifierRatings.has_value();
-    if (precalculatedSpeeds) {
-        switch (modifiers->_songSpeed) {
-            case GameplayModifiers::SongSpeed::Slower:
-                passRating = map.ModifierRatings->ssPassRating;
-                accRating = map.ModifierRatings->ssAccRating;
-                techRating = map.ModifierRatings->ssTechRating;
-                break;
-            case GameplayModifiers::SongSpeed::Faster:
-                passRating = map.ModifierRatings->fsPassRating;
-                accRating = map.ModifierRatings->fsAccRating;
-                techRating = map.ModifierRatings->fsTechRating;
-                break;
-            case GameplayModifiers::SongSpeed::SuperFast:
-                passRating = map.ModifierRatings->sfPassRating;
-                accRating = map.ModifierRatings->sfAccRating;
-                techRating = map.ModifierRatings->sfTechRating;
-                break;
-            default:
-                break;
+    uint32_t counted = modifiers;
+    if (map.ModifierRatings.has_value()) {
+        if (modifiers & SlowerSong) {
+            passRating = map.ModifierRatings->ssPassRating;
+            accRating = map.ModifierRatings->ssAccRating;
+            techRating = map.ModifierRatings->ssTechRating;
+        } else if (modifiers & FasterSong) {
+            passRating = map.ModifierRatings->fsPassRating;
+            accRating = map.ModifierRatings->fsAccRating;
+            techRating = map.ModifierRatings->fsTechRating;
+        } else if (modifiers & SuperFastSong) {
+            passRating = map.ModifierRatings->sfPassRating;
+            accRating = map.ModifierRatings->sfAccRating;
+            techRating = map.ModifierRatings->sfTechRating;
         }
+        counted &= ~(SlowerSong | FasterSong | SuperFastSong);
     }
+    // no fail only applies after failing
+    if (!failed)
+        counted &= ~NoFail;
 
+    // added in bit order, the same as the order of GetModStringsBL, only looking up the few enabled modifiers
     float multiplier = 1;
-    auto const mods = GetModStringsBL(modifiers, !precalculatedSpeeds, failed);
-    for (auto& mod : mods) {
-        auto value = map.ModifierValues.find(mod);
+    for (int i = 0; counted != 0; i++, counted >>= 1) {
+        if (!(counted & 1))
+            continue;
+        auto value = map.ModifierValues.find(ModifierCodes[i]);
         if (value != map.ModifierValues.end())
             multiplier += value->second;
     }
-    passRating *= multiplier;
-    accRating *= multiplier;
-    techRating *= multiplier;
+    return {passRating * multiplier, accRating * multiplier, techRating * multiplier};
+}
+
+float PP::Calculate(PP::BLSongDiff const& map, float percentage, GameplayModifiers* modifiers, bool failed) {
+    uint32_t mask = GetModifierMask(modifiers);
+    // failing without no fail ends the play, which gives no pp
+    if (failed && !(mask & NoFail))
+        return 0;
+    auto const [passRating, accRating, techRating] = GetRatings(map, mask, failed);
 
     logger.debug("calculating pp with ratings {} {} {}", passRating, accRating, techRating);
 
-    auto const [passPP, accPP, techPP] = CalculatePP(percentage, accRating, passRating, techRating);
-    auto const rawPP = Inflate(passPP + accPP + techPP);
-    return rawPP;
+    return CalculateBL(percentage, passRating, accRating, techRating);
+}
+
+float PP::Calculate(PP::BLSongDiff const& map, float percentage, uint32_t modifiers, bool failed) {
+    if (failed && !(modifiers & NoFail))
+        return 0;
+    auto const [passRating, accRating, techRating] = GetRatings(map, modifiers, failed);
+    return CalculateBL(percentage, passRating, accRating, techRating);
 }
 
 float PP::Calculate(PP::SSSongDiff const& map, float percentage, GameplayModifiers* modifiers, bool failed) {
-    if (failed)
-        percentage /= 2;
-    float const multiplier = AccCurve(percentage, ScoreSaberCurve);
-    return multiplier * map * ScoresaberMult;
+    return CalculateSS(percentage, map, failed);
+}
+
+void PP::Calculate(BLSongDiff const& map, std::span<float const> accuracies, std::span<float> results, GameplayModifiers* modifiers, bool failed) {
+    uint32_t mask = GetModifierMask(modifiers);
+    if (failed && !(mask & NoFail)) {
+        std::fill_n(results.begin(), std::min(accuracies.size(), results.size()), 0);
+        return;
+    }
+    auto const [passRating, accRating, techRating] = GetRatings(map, mask, failed);
+    CalculateBL(accuracies, results, passRating, accRating, techRating);
+}
+
+void PP::Calculate(SSSongDiff const& map, std::span<float const> accuracies, std::span<float> results, GameplayModifiers* modifiers, bool failed) {
+    CalculateSS(accuracies, results, map, failed);
+}
+
+float PP::RequiredAccuracy(BLSongDiff const& map, float targetPP, GameplayModifiers* modifiers) {
+    auto const [passRating, accRating, techRating] = GetRatings(map, GetModifierMask(modifiers));
+    return RequiredAccuracyBL(targetPP, passRating, accRating, techRating);
+}
+
+float PP::RequiredAccuracy(SSSongDiff const& map, float targetPP, GameplayModifiers* modifiers) {
+    return RequiredAccuracySS(targetPP, map);
+}
+
+void PP::RequiredAccuracy(BLSongDiff const& map, std::span<float const> targetPPs, std::span<float> results, GameplayModifiers* modifiers) {
+    auto const [passRating, accRating, techRating] = GetRatings(map, GetModifierMask(modifiers));
+    RequiredAccuracyBL(targetPPs, results, passRating, accRating, techRating);
+}
+
+void PP::RequiredAccuracy(SSSongDiff const& map, std::span<float const> targetPPs, std::span<float> results, GameplayModifiers* modifiers) {
+    RequiredAccuracySS(targetPPs, results, map);
 }
 
 static void ProcessResponseBL(PP::BLSong song, BeatmapKey map) {
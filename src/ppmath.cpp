@@ -0,0 +1,193 @@
+#include "ppmath.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <tuple>
+
+using namespace MetaCore;
+
+static constexpr double ScoresaberMult = 42.117208413;
+
+std::vector<std::pair<double, double>> const PP::BeatLeaderCurve(BeatLeaderTable.points.begin(), BeatLeaderTable.points.end());
+
+std::vector<std::pair<double, double>> const PP::ScoreSaberCurve(ScoreSaberTable.points.begin(), ScoreSaberTable.points.end());
+
+float PP::AccCurve(float acc, std::vector<std::pair<double, double>> const& curve) {
+    if (&curve == &BeatLeaderCurve)
+        return BeatLeaderTable(acc);
+    if (&curve == &ScoreSaberCurve)
+        return ScoreSaberTable(acc);
+
+    int i = 1;
+    for (; i < curve.size() - 1; i++) {
+        if (curve[i].first <= acc)
+            break;
+    }
+
+    double const middle_dis = (acc - curve[i - 1].first) / (curve[i].first - curve[i - 1].first);
+    return curve[i - 1].second + middle_dis * (curve[i].second - curve[i - 1].second);
+}
+
+static float PassPP(float passRating) {
+    float passPP = passRating > 0 ? 15.2 * std::exp(std::pow(passRating, 1 / 2.62)) - 30 : 0;
+    if (passPP < 0)
+        passPP = 0;
+    return passPP;
+}
+
+static inline float AccPP(float curve, float accRating) {
+    return curve * accRating * 34;
+}
+
+static inline float TechPP(float accuracy, float techRating) {
+    return std::exp(1.9 * accuracy) * 1.08 * techRating;
+}
+
+static std::tuple<float, float, float> CalculatePP(float accuracy, float accRating, float passRating, float techRating) {
+    float const passPP = PassPP(passRating);
+    float const accPP = AccPP(PP::BeatLeaderTable(accuracy), accRating);
+    float const techPP = TechPP(accuracy, techRating);
+
+    return {passPP, accPP, techPP};
+}
+
+static inline float Inflate(float pp) {
+    return 650 * std::pow(pp, 1.3) / std::pow(650, 1.3);
+}
+
+float PP::CalculateBL(float accuracy, float passRating, float accRating, float techRating) {
+    auto const [passPP, accPP, techPP] = CalculatePP(accuracy, accRating, passRating, techRating);
+    return Inflate(passPP + accPP + techPP);
+}
+
+float PP::CalculateSS(float accuracy, float stars, bool failed) {
+    if (failed)
+        accuracy /= 2;
+    float const multiplier = ScoreSaberTable(accuracy);
+    return multiplier * stars * ScoresaberMult;
+}
+
+// the batch versions do the same operations as the single versions (so the results are identical), with the parts that
+// don't depend on accuracy done once and the curve lookups split from the arithmetic
+// only the ScoreSaber arithmetic vectorizes, since exp and pow are still called per accuracy for BeatLeader
+
+void PP::CalculateBL(std::span<float const> accuracies, std::span<float> results, float passRating, float accRating, float techRating) {
+    size_t const count = std::min(accuracies.size(), results.size());
+    float const passPP = PassPP(passRating);
+    for (size_t i = 0; i < count; i++)
+        results[i] = BeatLeaderTable(accuracies[i]);
+    for (size_t i = 0; i < count; i++) {
+        float const accPP = AccPP(results[i], accRating);
+        float const techPP = TechPP(accuracies[i], techRating);
+        results[i] = Inflate(passPP + accPP + techPP);
+    }
+}
+
+void PP::CalculateSS(std::span<float const> accuracies, std::span<float> results, float stars, bool failed) {
+    size_t const count = std::min(accuracies.size(), results.size());
+    for (size_t i = 0; i < count; i++)
+        results[i] = ScoreSaberTable(failed ? accuracies[i] / 2 : accuracies[i]);
+    for (size_t i = 0; i < count; i++)
+        results[i] = results[i] * stars * ScoresaberMult;
+}
+
+// the solvers work in doubles, so search nearby for the lowest float accuracy that actually reaches the target
+// (the bits of non-negative floats are ordered the same as their values, and flat parts of the curves can span many floats)
+template <class F>
+static float Refine(float accuracy, float targetPP, F&& calculate) {
+    auto const reaches = [&](uint32_t bits) { return calculate(std::bit_cast<float>(bits)) >= targetPP; };
+    uint32_t const one = std::bit_cast<uint32_t>(1.0f);
+    uint32_t high = std::bit_cast<uint32_t>(std::clamp(accuracy, 0.0f, 1.0f));
+    for (uint32_t step = 1; high < one && !reaches(high); step *= 2)
+        high = std::min(high + step, one);
+    uint32_t low = high;
+    for (uint32_t step = 1; low > 0 && reaches(low); step *= 2)
+        low = low > step ? low - step : 0;
+    if (reaches(low))
+        return 0;
+    while (high - low > 1) {
+        uint32_t const middle = low + (high - low) / 2;
+        if (reaches(middle))
+            high = middle;
+        else
+            low = middle;
+    }
+    return std::bit_cast<float>(high);
+}
+
+// finds i where value(i - 1) >= target > value(i), for points sorted from highest to lowest accuracy with value(0) >= target > value(last)
+template <class F>
+static int FindSegment(std::span<PP::CurvePoint const> points, double target, F&& value) {
+    int low = 1;
+    int high = points.size() - 1;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (value(points[middle]) < target)
+            high = middle;
+        else
+            low = middle + 1;
+    }
+    return low;
+}
+
+float PP::RequiredAccuracyBL(float targetPP, float passRating, float accRating, float techRating) {
+    auto const calculate = [&](float accuracy) { return CalculateBL(accuracy, passRating, accRating, techRating); };
+    if (calculate(1) < targetPP)
+        return -1;
+    if (calculate(0) >= targetPP)
+        return 0;
+
+    // the inverse of Inflate, and pass PP doesn't depend on accuracy
+    double const target = std::pow(targetPP * std::pow(650, 1.3) / 650, 1 / 1.3) - PassPP(passRating);
+    auto const terms = [&](double accuracy, double curve) {
+        return curve * accRating * 34 + std::exp(1.9 * accuracy) * 1.08 * techRating;
+    };
+    auto const& points = BeatLeaderTable.points;
+    int i = FindSegment(points, target, [&](CurvePoint const& point) { return terms(point.first, point.second); });
+
+    // the terms are convex within a segment, so newton's method from the top never overshoots
+    double const low = points[i].first;
+    double const high = points[i - 1].first;
+    double const slope = (points[i - 1].second - points[i].second) / (high - low);
+    double accuracy = high;
+    for (int iteration = 0; iteration < 8; iteration++) {
+        double const curve = points[i].second + (accuracy - low) * slope;
+        double const derivative = slope * accRating * 34 + 1.9 * std::exp(1.9 * accuracy) * 1.08 * techRating;
+        if (derivative <= 0)
+            break;
+        double const step = (terms(accuracy, curve) - target) / derivative;
+        accuracy = std::clamp(accuracy - step, low, high);
+        if (std::abs(step) < 1e-9)
+            break;
+    }
+    return Refine(accuracy, targetPP, calculate);
+}
+
+float PP::RequiredAccuracySS(float targetPP, float stars) {
+    auto const calculate = [&](float accuracy) { return CalculateSS(accuracy, stars, false); };
+    if (calculate(1) < targetPP)
+        return -1;
+    if (calculate(0) >= targetPP)
+        return 0;
+
+    // the curve is the only part that depends on accuracy, so the segment can be inverted directly
+    double const target = targetPP / (stars * ScoresaberMult);
+    auto const& points = ScoreSaberTable.points;
+    int i = FindSegment(points, target, [](CurvePoint const& point) { return point.second; });
+    double const middle_dis = (target - points[i - 1].second) / (points[i].second - points[i - 1].second);
+    double const accuracy = points[i - 1].first + middle_dis * (points[i].first - points[i - 1].first);
+    return Refine(accuracy, targetPP, calculate);
+}
+
+void PP::RequiredAccuracyBL(std::span<float const> targetPPs, std::span<float> results, float passRating, float accRating, float techRating) {
+    size_t const count = std::min(targetPPs.size(), results.size());
+    for (size_t i = 0; i < count; i++)
+        results[i] = RequiredAccuracyBL(targetPPs[i], passRating, accRating, techRating);
+}
+
+void PP::RequiredAccuracySS(std::span<float const> targetPPs, std::span<float> results, float stars) {
+    size_t const count = std::min(targetPPs.size(), results.size());
+    for (size_t i = 0; i < count; i++)
+        results[i] = RequiredAccuracySS(targetPPs[i], stars);
+}
@@ -0,0 +1,24 @@
+#include "scoring.hpp"
+
+#include <algorithm>
+
+using namespace MetaCore;
+
+void Scoring::ComputeMaxScores(std::vector<Element>& elements, std::vector<float>& times, std::vector<int>& totals) {
+    std::stable_sort(elements.begin(), elements.end(), [](auto const& a, auto const& b) { return a.time < b.time; });
+
+    times.reserve(times.size() + elements.size());
+    totals.reserve(totals.size() + elements.size());
+    int multiplier = 1;
+    int progress = 0;
+    int total = 0;
+    for (auto const& [time, score] : elements) {
+        if (multiplier < 8 && ++progress >= multiplier * 2) {
+            multiplier *= 2;
+            progress = 0;
+        }
+        total += score * multiplier;
+        times.emplace_back(time);
+        totals.emplace_back(total);
+    }
+}
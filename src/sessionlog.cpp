@@ -0,0 +1,254 @@
+#include "sessionlog.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#include "main.hpp"
+#include "session.hpp"
+
+using namespace MetaCore;
+
+// session log layout:
+//   header: magic, version, sizeof(Record), uint16 beatmap length, beatmap
+//   blocks: up to BlockRecords records each, written as they fill up
+//   index (only if finished): per block uint64 file offset, uint32 record count, float first and last song time
+//   trailer: uint32 block count, uint64 index offset, magic
+
+static constexpr uint32_t Magic = 0x3153434d;  // "MCS1"
+static constexpr uint32_t Version = 1;
+static constexpr int BlockRecords = 1024;
+static constexpr int TrailerSize = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+
+struct Block {
+    std::array<SessionLog::Record, BlockRecords> records;
+    int count = 0;
+};
+
+struct IndexEntry {
+    uint64_t offset;
+    uint32_t count;
+    float start;
+    float end;
+};
+
+template <class T>
+static void Write(std::ofstream& file, T const& value) {
+    file.write((char const*) &value, sizeof(T));
+}
+
+template <class T>
+static bool Read(std::ifstream& file, T& value) {
+    return (bool) file.read((char*) &value, sizeof(T));
+}
+
+// the hooks fill one block while the writer thread writes the other
+static std::array<Block, 2> blocks;
+static int active = 0;
+static bool logging = false;
+
+static std::ofstream file;
+// the block waiting to be written, or -1
+static std::atomic<int> pending = -1;
+static std::atomic<bool> stopping = false;
+// changed whenever the writer thread has something new to do, so it can wait without a lock
+static std::atomic<uint32_t> wakeups = 0;
+
+// only used by the writer thread until it is joined
+static std::vector<IndexEntry> blockIndex;
+static uint64_t offset = 0;
+
+// joined lazily, by the next log or on exit, declared after everything the thread uses so it is destroyed first
+static struct Writer {
+    std::thread thread;
+    ~Writer() {
+        SessionLog::Finish();
+        SessionLog::Join();
+    }
+} writer;
+
+static bool autoLog = false;
+static std::string autoLogDirectory;
+
+static void WriteBlock(Block const& block) {
+    IndexEntry entry = {.offset = offset, .count = (uint32_t) block.count, .start = block.records[0].songTime, .end = block.records[0].songTime};
+    for (int i = 1; i < block.count; i++) {
+        entry.start = std::min(entry.start, block.records[i].songTime);
+        entry.end = std::max(entry.end, block.records[i].songTime);
+    }
+    file.write((char const*) block.records.data(), block.count * sizeof(SessionLog::Record));
+    blockIndex.emplace_back(entry);
+    offset += block.count * sizeof(SessionLog::Record);
+}
+
+static void WriteIndex() {
+    uint64_t indexOffset = offset;
+    for (auto const& entry : blockIndex) {
+        Write(file, entry.offset);
+        Write(file, entry.count);
+        Write(file, entry.start);
+        Write(file, entry.end);
+    }
+    Write(file, (uint32_t) blockIndex.size());
+    Write(file, indexOffset);
+    Write(file, Magic);
+}
+
+static void WakeWriter() {
+    wakeups.fetch_add(1, std::memory_order_release);
+    wakeups.notify_one();
+}
+
+static void WriterThread() {
+    while (true) {
+        // read before checking for work, so anything submitted after the checks changes it and ends the wait
+        uint32_t seen = wakeups.load(std::memory_order_acquire);
+        if (int block = pending.load(std::memory_order_acquire); block >= 0) {
+            WriteBlock(blocks[block]);
+            pending.store(-1, std::memory_order_release);
+            pending.notify_one();
+        } else if (stopping.load(std::memory_order_acquire))
+            break;
+        else
+            wakeups.wait(seen, std::memory_order_acquire);
+    }
+    // the hooks are done with the active block once stopping, so the rest of the log is finished here instead of on the main thread
+    if (blocks[active].count > 0)
+        WriteBlock(blocks[active]);
+    WriteIndex();
+    file.close();
+}
+
+static void Submit() {
+    // only waits if a whole block was logged before the previous one was written
+    for (int block; (block = pending.load(std::memory_order_acquire)) >= 0;)
+        pending.wait(block, std::memory_order_acquire);
+    pending.store(active, std::memory_order_release);
+    active = 1 - active;
+    blocks[active].count = 0;
+    WakeWriter();
+}
+
+bool SessionLog::Begin(std::string const& path, std::string const& beatmap) {
+    Finish();
+    // the previous log could still be writing its last block and index
+    Join();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        logger.error("Failed to open {} for session log", path);
+        return false;
+    }
+    logger.info("Writing session log to {}", path);
+    Write(file, Magic);
+    Write(file, Version);
+    Write(file, (uint32_t) sizeof(Record));
+    Write(file, (uint16_t) beatmap.size());
+    file.write(beatmap.data(), beatmap.size());
+
+    blockIndex.clear();
+    offset = file.tellp();
+    blocks[0].count = 0;
+    blocks[1].count = 0;
+    active = 0;
+    pending = -1;
+    stopping = false;
+    writer.thread = std::thread(WriterThread);
+    logging = true;
+    return true;
+}
+
+void SessionLog::BeginAuto(std::string const& beatmap) {
+    if (!autoLog)
+        return;
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    Begin(fmt::format("{}/{}.mcs", autoLogDirectory, millis), beatmap);
+}
+
+void SessionLog::Log(Record const& record) {
+    if (!logging)
+        return;
+    auto& block = blocks[active];
+    block.records[block.count++] = record;
+    if (block.count == BlockRecords)
+        Submit();
+}
+
+void SessionLog::Finish() {
+    if (!logging)
+        return;
+    logging = false;
+    stopping.store(true, std::memory_order_release);
+    WakeWriter();
+}
+
+void SessionLog::Join() {
+    if (writer.thread.joinable())
+        writer.thread.join();
+}
+
+void SessionLog::SetEnabled(bool enabled, std::string directory) {
+    autoLog = enabled;
+    autoLogDirectory = std::move(directory);
+}
+
+bool SessionLog::IsLogging() {
+    return logging;
+}
+
+static void ReadRecords(std::ifstream& file, uint32_t count, float start, float end, std::vector<SessionLog::Record>& ret) {
+    SessionLog::Record record;
+    for (uint32_t i = 0; i < count && Read(file, record); i++) {
+        if (record.songTime >= start && record.songTime <= end)
+            ret.emplace_back(record);
+    }
+}
+
+std::vector<SessionLog::Record> SessionLog::Read(std::string path, float start, float end, std::string* beatmap) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t magic, version, size;
+    uint16_t length;
+    if (!::Read(file, magic) || !::Read(file, version) || !::Read(file, size) || !::Read(file, length) || magic != Magic || version != Version ||
+        size != sizeof(Record)) {
+        logger.error("Failed to read session log {}", path);
+        return {};
+    }
+    std::string key(length, '\0');
+    if (!file.read(key.data(), length)) {
+        logger.error("Failed to read session log {}", path);
+        return {};
+    }
+    if (beatmap)
+        *beatmap = std::move(key);
+    std::streamoff recordsOffset = file.tellg();
+
+    std::vector<Record> ret;
+
+    uint32_t blockCount = 0;
+    uint64_t indexOffset = 0;
+    file.seekg(-TrailerSize, std::ios::end);
+    if (!file || !::Read(file, blockCount) || !::Read(file, indexOffset) || !::Read(file, magic) || magic != Magic) {
+        // the log was not finished (such as if the game closed), so read every block that was written
+        file.clear();
+        file.seekg(recordsOffset);
+        ReadRecords(file, std::numeric_limits<uint32_t>::max(), start, end, ret);
+        return ret;
+    }
+
+    std::vector<IndexEntry> entries(blockCount);
+    file.seekg(indexOffset);
+    for (auto& entry : entries) {
+        if (!::Read(file, entry.offset) || !::Read(file, entry.count) || !::Read(file, entry.start) || !::Read(file, entry.end)) {
+            logger.error("Failed to read session log index {}", path);
+            return {};
+        }
+    }
+    for (auto const& entry : entries) {
+        if (entry.end < start || entry.start > end)
+            continue;
+        file.seekg(entry.offset);
+        ReadRecords(file, entry.count, start, end, ret);
+    }
+    return ret;
+}
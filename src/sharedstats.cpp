@@ -0,0 +1,79 @@
+#include "sharedstats.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <new>
+
+#include "main.hpp"
+#include "publish.hpp"
+
+using namespace MetaCore;
+
+static SharedStats::Layout* layout = nullptr;
+
+static void* Map(std::string const& path, bool write) {
+    int file = open(path.c_str(), write ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+    if (file < 0)
+        return nullptr;
+    bool sized;
+    if (write)
+        sized = ftruncate(file, sizeof(SharedStats::Layout)) == 0;
+    else {
+        // accessing past the end of a shorter file would crash
+        struct stat info;
+        sized = fstat(file, &info) == 0 && info.st_size >= sizeof(SharedStats::Layout);
+    }
+    if (!sized) {
+        close(file);
+        return nullptr;
+    }
+    void* ret = mmap(nullptr, sizeof(SharedStats::Layout), write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+    // the mapping stays valid after closing
+    close(file);
+    return ret == MAP_FAILED ? nullptr : ret;
+}
+
+bool SharedStats::Enable(std::string path) {
+    Disable();
+    auto memory = Map(path, true);
+    if (!memory) {
+        logger.error("Failed to map {} for shared stats", path);
+        return false;
+    }
+    // the snapshot stays empty until the next time stats are published
+    layout = new (memory) Layout{.magic = Magic, .version = Version, .size = sizeof(Layout), .reserved = 0};
+    logger.info("Exporting shared stats to {}", path);
+    return true;
+}
+
+void SharedStats::Disable() {
+    if (!layout)
+        return;
+    munmap(layout, sizeof(Layout));
+    layout = nullptr;
+}
+
+bool SharedStats::IsEnabled() {
+    return layout != nullptr;
+}
+
+void SharedStats::Publish(Stats::Snapshot const& snapshot) {
+    if (layout)
+        layout->snapshot.Write(snapshot);
+}
+
+SharedStats::Layout const* SharedStats::Open(std::string path) {
+    auto ret = (Layout const*) Map(path, false);
+    if (ret && (ret->magic != Magic || ret->version != Version)) {
+        Close(ret);
+        return nullptr;
+    }
+    return ret;
+}
+
+void SharedStats::Close(Layout const* layout) {
+    munmap((void*) layout, sizeof(Layout));
+}
@@ -1,7 +1,11 @@
 #include "stats.hpp"
 
+#include <cmath>
+
 #include "internals.hpp"
 #include "main.hpp"
+#include "publish.hpp"
+#include "seqlock.hpp"
 
 static inline bool IsLeft(int saber) {
     return saber == MetaCore::Stats::LeftSaber || saber == MetaCore::Stats::BothSabers;
@@ -44,6 +48,10 @@ int MetaCore::Stats::GetSongMaxScore() {
     return Internals::songMaxScore;
 }
 
+int MetaCore::Stats::GetSongMaxScoreAtTime(float time) {
+    return Internals::GetMaxScoreAtTime(time);
+}
+
 int MetaCore::Stats::GetCombo(int saber) {
     if (saber == LeftSaber)
         return Internals::leftCombo;
@@ -260,17 +268,15 @@ float MetaCore::Stats::GetTimeDependence(int saber) {
 }
 
 float MetaCore::Stats::GetAverageSpeed(int saber) {
-    float ret = 0;
+    double ret = 0;
     int div = 0;
     if (IsLeft(saber)) {
-        for (auto& val : Internals::leftSpeeds)
-            ret += val;
-        div += Internals::leftSpeeds.size();
+        ret += Internals::leftSpeedHistory.sum();
+        div += Internals::leftSpeedHistory.count();
     }
     if (IsRight(saber)) {
-        for (auto& val : Internals::rightSpeeds)
-            ret += val;
-        div += Internals::rightSpeeds.size();
+        ret += Internals::rightSpeedHistory.sum();
+        div += Internals::rightSpeedHistory.count();
     }
     if (div == 0)
         return 0;
@@ -278,53 +284,90 @@ float MetaCore::Stats::GetAverageSpeed(int saber) {
 }
 
 float MetaCore::Stats::GetBestSpeed5Secs(int saber) {
+    return GetBestSpeed(saber, 5);
+}
+
+float MetaCore::Stats::GetLastSecAngle(int saber) {
     float ret = 0;
-    int back = SLOW_UPDATES_PER_SEC * 5;
-    if (IsLeft(saber)) {
-        int size = Internals::leftSpeeds.size();
-        int start = std::max(0, size - back);
-        for (int i = start; i < size; i++)
-            ret = std::max(ret, Internals::leftSpeeds[i]);
-    }
-    if (IsRight(saber)) {
-        int size = Internals::rightSpeeds.size();
-        int start = std::max(0, size - back);
-        for (int i = start; i < size; i++)
-            ret = std::max(ret, Internals::rightSpeeds[i]);
-    }
+    if (IsLeft(saber))
+        ret += Internals::leftAngleHistory.window(SLOW_UPDATES_PER_SEC).sum();
+    if (IsRight(saber))
+        ret += Internals::rightAngleHistory.window(SLOW_UPDATES_PER_SEC).sum();
+    if (saber == (int) BothSabers)
+        ret /= 2;
     return ret;
 }
 
-float MetaCore::Stats::GetLastSecAngle(int saber) {
+float MetaCore::Stats::GetHighestSecAngle(int saber) {
+    float ret = 0;
+    if (IsLeft(saber))
+        ret = std::max(ret, Internals::leftAngleHistory.max());
+    if (IsRight(saber))
+        ret = std::max(ret, Internals::rightAngleHistory.max());
+    return ret * SLOW_UPDATES_PER_SEC;
+}
+
+static inline int WindowLength(float seconds) {
+    // clamped before converting, as the windows can't be longer than the history anyway
+    float length = std::round(seconds * SLOW_UPDATES_PER_SEC);
+    return std::clamp(length, 1.f, (float) Internals::SaberHistory::capacity());
+}
+
+float MetaCore::Stats::GetAverageSpeed(int saber, float seconds) {
+    int length = WindowLength(seconds);
     float ret = 0;
-    int back = SLOW_UPDATES_PER_SEC;
+    int div = 0;
     if (IsLeft(saber)) {
-        int size = Internals::leftAngles.size();
-        int start = std::max(0, size - back);
-        for (int i = start; i < size; i++)
-            ret += Internals::leftAngles[i];
+        auto& window = Internals::leftSpeedHistory.window(length);
+        ret += window.sum();
+        div += window.size();
     }
     if (IsRight(saber)) {
-        int size = Internals::rightAngles.size();
-        int start = std::max(0, size - back);
-        for (int i = start; i < size; i++)
-            ret += Internals::rightAngles[i];
+        auto& window = Internals::rightSpeedHistory.window(length);
+        ret += window.sum();
+        div += window.size();
     }
-    if (saber == (int) BothSabers)
-        ret /= 2;
+    if (div == 0)
+        return 0;
+    return ret / div;
+}
+
+float MetaCore::Stats::GetBestSpeed(int saber, float seconds) {
+    int length = WindowLength(seconds);
+    float ret = 0;
+    if (IsLeft(saber))
+        ret = std::max(ret, Internals::leftSpeedHistory.window(length).max());
+    if (IsRight(saber))
+        ret = std::max(ret, Internals::rightSpeedHistory.window(length).max());
     return ret;
 }
 
-float MetaCore::Stats::GetHighestSecAngle(int saber) {
+float MetaCore::Stats::GetAverageAngle(int saber, float seconds) {
+    int length = WindowLength(seconds);
     float ret = 0;
+    int div = 0;
     if (IsLeft(saber)) {
-        for (auto& val : Internals::leftAngles)
-            ret = std::max(ret, val);
+        auto& window = Internals::leftAngleHistory.window(length);
+        ret += window.sum();
+        div += window.size();
     }
     if (IsRight(saber)) {
-        for (auto& val : Internals::rightAngles)
-            ret = std::max(ret, val);
+        auto& window = Internals::rightAngleHistory.window(length);
+        ret += window.sum();
+        div += window.size();
     }
+    if (div == 0)
+        return 0;
+    return ret / div * SLOW_UPDATES_PER_SEC;
+}
+
+float MetaCore::Stats::GetHighestAngle(int saber, float seconds) {
+    int length = WindowLength(seconds);
+    float ret = 0;
+    if (IsLeft(saber))
+        ret = std::max(ret, Internals::leftAngleHistory.window(length).max());
+    if (IsRight(saber))
+        ret = std::max(ret, Internals::rightAngleHistory.window(length).max());
     return ret * SLOW_UPDATES_PER_SEC;
 }
 
@@ -363,3 +406,46 @@ int MetaCore::Stats::GetFCScore(int saber) {
     }
     return (missed * swingRatio) + fixed + GetScore(saber);
 }
+
+static MetaCore::SeqLock<MetaCore::Stats::Snapshot> snapshots;
+
+void MetaCore::Stats::PublishSnapshot() {
+    Snapshot snapshot = {
+        .sequence = (int) snapshots.Count(),
+        .valid = Internals::stateValid,
+        .songTime = GetSongTime(),
+        .songLength = GetSongLength(),
+        .songSpeed = GetSongSpeed(),
+        .health = GetHealth(),
+        .multiplier = GetMultiplier(),
+        .songMaxScore = GetSongMaxScore(),
+        .modifierMultiplier = GetModifierMultiplier(true, true),
+        .wallsHit = GetWallsHit(),
+        .songNotes = GetSongNotes(BothSabers),
+        .personalBest = GetBestScore(),
+        .fails = GetFails(),
+        .restarts = GetRestarts(),
+    };
+    for (int saber = LeftSaber; saber <= BothSabers; saber++) {
+        snapshot.score[saber] = GetScore(saber);
+        snapshot.maxScore[saber] = GetMaxScore(saber);
+        snapshot.combo[saber] = GetCombo(saber);
+        snapshot.highestCombo[saber] = GetHighestCombo(saber);
+        snapshot.notesCut[saber] = GetNotesCut(saber);
+        snapshot.notesMissed[saber] = GetNotesMissed(saber);
+        snapshot.notesBadCut[saber] = GetNotesBadCut(saber);
+        snapshot.bombsHit[saber] = GetBombsHit(saber);
+        snapshot.notesRemaining[saber] = GetNotesRemaining(saber);
+        snapshot.preSwing[saber] = GetPreSwing(saber);
+        snapshot.postSwing[saber] = GetPostSwing(saber);
+        snapshot.accuracy[saber] = GetAccuracy(saber);
+        snapshot.timeDependence[saber] = GetTimeDependence(saber);
+        snapshot.averageSpeed[saber] = GetAverageSpeed(saber);
+    }
+    snapshots.Write(snapshot);
+    SharedStats::Publish(snapshot);
+}
+
+MetaCore::Stats::Snapshot MetaCore::Stats::GetSnapshot() {
+    return snapshots.Read();
+}
@@ -1,5 +1,6 @@
 #include "strings.hpp"
 
+#include <algorithm>
 #include <filesystem>
 
 std::string MetaCore::Strings::SanitizedPath(std::string const& path) {
@@ -0,0 +1,144 @@
+#include "timeline.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "cuts.hpp"
+
+using namespace MetaCore;
+
+// all columns live in one allocation, each starting on its own cache line
+enum Column {
+    NoteKinds,
+    Times,
+    Sabers,
+    BeforeCutScores,
+    AfterCutScores,
+    CenterCutScores,
+    CutDistances,
+    TimeDeviations,
+    CutAngles,
+    Multipliers,
+    ColumnCount,
+};
+
+static constexpr size_t Alignment = 64;
+
+// every column value is 4 bytes
+static_assert(sizeof(float) == 4 && sizeof(int) == 4);
+
+static std::byte* arena = nullptr;
+static int capacity = 0;
+static int size = 0;
+
+static size_t Stride(int capacity) {
+    return (capacity * sizeof(float) + Alignment - 1) / Alignment * Alignment;
+}
+
+template <class T>
+static T* GetColumn(Column column) {
+    return (T*) (arena + column * Stride(capacity));
+}
+
+template <class T>
+static std::span<T const> GetSpan(Column column) {
+    if (!arena)
+        return {};
+    return {GetColumn<T>(column), (size_t) size};
+}
+
+static void Reserve(int newCapacity) {
+    size_t stride = Stride(newCapacity);
+    auto newArena = (std::byte*) ::operator new(stride * ColumnCount, std::align_val_t(Alignment));
+    if (arena) {
+        for (int column = 0; column < ColumnCount; column++)
+            std::memcpy(newArena + column * stride, arena + column * Stride(capacity), size * sizeof(float));
+        ::operator delete(arena, std::align_val_t(Alignment));
+    }
+    arena = newArena;
+    capacity = newCapacity;
+}
+
+void Timeline::Reset(int notes) {
+    size = 0;
+    // keep the arena from previous maps if it is large enough
+    if (notes > capacity)
+        Reserve(notes);
+}
+
+void Timeline::Record(
+    int kind,
+    float time,
+    int saber,
+    int beforeCutScore,
+    int afterCutScore,
+    int centerCutScore,
+    float cutDistance,
+    float timeDeviation,
+    float cutAngle,
+    int multiplier
+) {
+    // more notes than expected, such as with modded maps that add them at runtime
+    if (size == capacity)
+        Reserve(std::max(64, capacity * 2));
+    GetColumn<int>(NoteKinds)[size] = kind;
+    GetColumn<float>(Times)[size] = time;
+    GetColumn<int>(Sabers)[size] = saber;
+    GetColumn<int>(BeforeCutScores)[size] = beforeCutScore;
+    GetColumn<int>(AfterCutScores)[size] = afterCutScore;
+    GetColumn<int>(CenterCutScores)[size] = centerCutScore;
+    GetColumn<float>(CutDistances)[size] = cutDistance;
+    GetColumn<float>(TimeDeviations)[size] = timeDeviation;
+    GetColumn<float>(CutAngles)[size] = cutAngle;
+    GetColumn<int>(Multipliers)[size] = multiplier;
+    size++;
+}
+
+void Timeline::RecordMiss(int kind, float time, int saber, float cutDistance, float timeDeviation, float cutAngle, int multiplier) {
+    Record(kind, time, saber, 0, 0, 0, cutDistance, timeDeviation, cutAngle, multiplier);
+}
+
+int Timeline::GetNoteCount() {
+    return size;
+}
+
+std::span<int const> Timeline::GetKinds() {
+    return GetSpan<int>(NoteKinds);
+}
+
+std::span<float const> Timeline::GetTimes() {
+    return GetSpan<float>(Times);
+}
+
+std::span<int const> Timeline::GetSabers() {
+    return GetSpan<int>(Sabers);
+}
+
+std::span<int const> Timeline::GetBeforeCutScores() {
+    return GetSpan<int>(BeforeCutScores);
+}
+
+std::span<int const> Timeline::GetAfterCutScores() {
+    return GetSpan<int>(AfterCutScores);
+}
+
+std::span<int const> Timeline::GetCenterCutScores() {
+    return GetSpan<int>(CenterCutScores);
+}
+
+std::span<float const> Timeline::GetCutDistances() {
+    return GetSpan<float>(CutDistances);
+}
+
+std::span<float const> Timeline::GetTimeDeviations() {
+    return GetSpan<float>(TimeDeviations);
+}
+
+std::span<float const> Timeline::GetCutAngles() {
+    return GetSpan<float>(CutAngles);
+}
+
+std::span<int const> Timeline::GetMultipliers() {
+    return GetSpan<int>(Multipliers);
+}
@@ -1,5 +1,7 @@
 #include "types.hpp"
 
+#include "dispatch.hpp"
+
 DEFINE_TYPE(MetaCore, ObjectSignal);
 DEFINE_TYPE(MetaCore, EndDragHandler);
 DEFINE_TYPE(MetaCore, KeyboardCloseHandler);
@@ -30,6 +32,8 @@ static std::mutex updatesMutex;
 static std::vector<std::function<void()>> updates;
 
 void MetaCore::MainThreadScheduler::Update() {
+    Events::RunAsyncBroadcasts();
+
     std::unique_lock waitersLock(waitersMutex);
     std::unique_lock callbacksLock(callbacksMutex);
     std::unique_lock updatesLock(updatesMutex);
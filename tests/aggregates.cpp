@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "aggregates.hpp"
+
+using namespace MetaCore;
+
+template <int Capacity>
+static float BruteMax(History<Capacity> const& history, int length) {
+    float ret = 0;
+    for (int i = std::max(0, history.size() - length); i < history.size(); i++)
+        ret = std::max(ret, history[i]);
+    return ret;
+}
+
+TEST(Aggregates, WindowLengthIsClampedToCapacity) {
+    History<64> history;
+    for (int i = 0; i < 200; i++)
+        history.push(i % 13);
+
+    auto& window = history.window(1 << 30);
+    EXPECT_EQ(window.size(), 64);
+    EXPECT_EQ(window.max(), BruteMax(history, 64));
+    // any length past the capacity is the same window
+    EXPECT_EQ(&history.window(100000), &history.window(64));
+}
+
+TEST(Aggregates, ManyWindowLengthsStayCorrect) {
+    History<256> history;
+    for (int i = 0; i < 1000; i++) {
+        history.push((i * 37) % 101);
+        // more distinct lengths than are kept, so windows are constantly replaced
+        int length = 1 + (i * 7) % 50;
+        auto& window = history.window(length);
+        ASSERT_EQ(window.size(), std::min(length, history.size()));
+        ASSERT_EQ(window.max(), BruteMax(history, length)) << "length " << length << " after " << i;
+    }
+}
+
+TEST(Aggregates, RecentWindowsAreKept) {
+    History<128> history;
+    auto& window = history.window(10);
+    // fewer lengths than the limit, so the first window is never replaced
+    for (int length = 11; length < 10 + History<128>::MaxWindows; length++)
+        history.window(length);
+    for (int i = 0; i < 30; i++)
+        history.push(i);
+    EXPECT_EQ(&history.window(10), &window);
+    EXPECT_EQ(window.size(), 10);
+    EXPECT_EQ(window.sum(), 20 + 21 + 22 + 23 + 24 + 25 + 26 + 27 + 28 + 29);
+}
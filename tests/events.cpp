@@ -0,0 +1,183 @@
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "dispatch.hpp"
+#include "events.hpp"
+
+using namespace MetaCore;
+
+// a fresh custom event for each test, so callbacks from other tests never run
+static int NewEvent() {
+    static int next = 0;
+    return Events::RegisterEvent("events-test", next++);
+}
+
+TEST(Events, CallbacksAddedDuringDispatchRunNextBroadcast) {
+    int event = NewEvent();
+    int added = 0;
+    int outer = Events::AddCallback(event, [&]() {
+        if (added == 0)
+            Events::AddCallback(event, [&]() { added++; });
+    });
+    Events::Broadcast(event);
+    EXPECT_EQ(added, 0);
+    Events::RemoveCallback(outer);
+    Events::Broadcast(event);
+    EXPECT_EQ(added, 1);
+}
+
+TEST(Events, CallbacksRemovedDuringDispatchAreSkipped) {
+    int event = NewEvent();
+    int second = -1;
+    int calls = 0;
+    Events::AddCallback(event, [&]() { Events::RemoveCallback(second); });
+    second = Events::AddCallback(event, [&]() { calls++; });
+    Events::Broadcast(event);
+    Events::Broadcast(event);
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(Events, OnceCallbacksFireOnce) {
+    int event = NewEvent();
+    int calls = 0;
+    int global = 0;
+    Events::AddCallback(event, [&]() { calls++; }, true);
+    int globalId = Events::AddCallback([&](int broadcast) { global += broadcast == event; }, true);
+    for (int i = 0; i < 3; i++)
+        Events::Broadcast(event);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(global, 1);
+    // already removed, so this does nothing
+    Events::RemoveCallback(globalId);
+}
+
+TEST(Events, CoalescedCallbacksFireOncePerUpdate) {
+    int event = NewEvent();
+    int calls = 0;
+    int id = Events::AddCallback(event, [&]() { calls++; }, false, true);
+    for (int i = 0; i < 5; i++)
+        Events::Broadcast(event);
+    EXPECT_EQ(calls, 0);
+    Events::Broadcast(Events::Update);
+    EXPECT_EQ(calls, 1);
+    // nothing broadcast since the last update
+    Events::Broadcast(Events::Update);
+    EXPECT_EQ(calls, 1);
+    // also delivered before the map ends
+    Events::Broadcast(event);
+    Events::Broadcast(Events::MapEnded);
+    EXPECT_EQ(calls, 2);
+
+    Events::Broadcast(event);
+    Events::RemoveCallback(id);
+    Events::Broadcast(Events::Update);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(Events, ReentrantBroadcastIsDeferred) {
+    int event = NewEvent();
+    std::vector<std::string> order;
+    int depth = 0;
+    Events::AddCallback(event, [&]() {
+        order.emplace_back(fmt::format("start {}", depth));
+        if (depth++ == 0)
+            Events::Broadcast(event);
+        order.emplace_back("end");
+    });
+    Events::Broadcast(event);
+    EXPECT_EQ(order, (std::vector<std::string>{"start 0", "end", "start 1", "end"}));
+}
+
+TEST(Events, DeferralStopsAtMaxDepth) {
+    int event = NewEvent();
+    int calls = 0;
+    Events::AddCallback(event, [&]() {
+        calls++;
+        Events::Broadcast(event);
+    });
+    Events::Broadcast(event);
+    // the original broadcast, then 8 deferred ones before giving up
+    EXPECT_EQ(calls, 9);
+    // and it recovers afterwards
+    calls = 0;
+    Events::Broadcast(event);
+    EXPECT_EQ(calls, 9);
+}
+
+TEST(Events, DeferredPayloadsAreCopied) {
+    int event = NewEvent();
+    std::vector<int> received;
+    Events::AddPayloadCallback(event, [&](void const* data) {
+        received.emplace_back(*(int const*) data);
+        if (received.size() == 1) {
+            int value = 2;
+            Events::Broadcast(event, &value, sizeof(value));
+            // changed before the deferred broadcast is delivered
+            value = 3;
+        }
+    });
+    int value = 1;
+    Events::Broadcast(event, &value, sizeof(value));
+    EXPECT_EQ(received, (std::vector<int>{1, 2}));
+}
+
+TEST(Events, BroadcastAsyncDeliversEveryEvent) {
+    int event = NewEvent();
+    constexpr int Producers = 4;
+    constexpr int PerProducer = 10000;
+
+    struct Item {
+        int producer;
+        int index;
+    };
+    std::vector<std::vector<int>> received(Producers);
+    Events::AddPayloadCallback(event, [&](void const* data) {
+        auto item = (Item const*) data;
+        received[item->producer].emplace_back(item->index);
+    });
+
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < Producers; producer++) {
+        threads.emplace_back([event, producer]() {
+            for (int i = 0; i < PerProducer; i++) {
+                Item item = {producer, i};
+                Events::BroadcastAsync(event, &item, sizeof(item));
+            }
+        });
+    }
+    // drain while the producers are still running, like the main thread would
+    for (int i = 0; i < 100; i++)
+        Events::RunAsyncBroadcasts();
+    for (auto& thread : threads)
+        thread.join();
+    Events::RunAsyncBroadcasts();
+
+    for (int producer = 0; producer < Producers; producer++) {
+        ASSERT_EQ(received[producer].size(), PerProducer) << "producer " << producer;
+        // each producer's events stay in order
+        for (int i = 0; i < PerProducer; i++)
+            ASSERT_EQ(received[producer][i], i);
+    }
+}
+
+TEST(Events, ProfilingResolvesOwnersWhenTimed) {
+    int event = NewEvent();
+    // registered before profiling is enabled, so the owner is only known once the callback is timed
+    Events::AddCallback(event, []() {});
+    Events::ResetProfiling();
+    Events::SetProfiling(true);
+    Events::Broadcast(event);
+    Events::Broadcast(event);
+    Events::SetProfiling(false);
+
+    EXPECT_EQ(Events::GetEventStats(event).count, 2);
+    auto mods = Events::GetAllModStats();
+    ASSERT_EQ(mods.size(), 1);
+    // the callback was registered from this executable
+    EXPECT_EQ(mods.begin()->first, "metacore-tests");
+    EXPECT_EQ(mods.begin()->second.count, 2);
+    Events::ResetProfiling();
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include "counters.hpp"
+#include "events.hpp"
+#include "journal.hpp"
+
+using namespace MetaCore;
+
+static std::string TempPath(char const* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static bool Equal(Journal::Counters const& a, Journal::Counters const& b) {
+    return std::memcmp(&a, &b, sizeof(Journal::Counters)) == 0;
+}
+
+// every broadcast seen by a global callback, along with the statistics at that time
+struct Capture {
+    std::vector<int> events;
+    std::vector<Journal::Counters> counters;
+    int id;
+
+    Capture() {
+        id = Events::AddCallback([this](int event) {
+            events.emplace_back(event);
+            counters.emplace_back(Journal::GetCounters());
+        });
+    }
+    ~Capture() { Events::RemoveCallback(id); }
+};
+
+TEST(Journal, RecordAndReplay) {
+    auto path = TempPath("metacore-journal-roundtrip.mcj");
+    int custom = Events::RegisterEvent("journal-test", 3);
+    ASSERT_GT(custom, Events::EventMax);
+
+    Journal::SetCounters({});
+    auto recorded = std::make_unique<Capture>();
+    ASSERT_TRUE(Journal::StartRecording(path));
+    for (int i = 1; i <= 50; i++) {
+        Internals::leftScore += 115 * i;
+        Internals::combo = i % 7;
+        Internals::health = 1.f / i;
+        Internals::songTime = i * 0.25f;
+        Events::Broadcast(Events::ScoreChanged);
+        if (i % 7 == 0)
+            Events::Broadcast(Events::ComboChanged);
+        if (i % 10 == 0) {
+            Internals::restarts = i;
+            Events::Broadcast(custom);
+        }
+    }
+    Journal::StopRecording();
+    EXPECT_FALSE(Journal::IsRecording());
+    auto events = std::move(recorded->events);
+    auto counters = std::move(recorded->counters);
+    recorded.reset();
+
+    Journal::SetCounters({});
+    Capture replayed;
+    int broadcasts = Journal::Replay(path);
+
+    EXPECT_EQ(broadcasts, events.size());
+    ASSERT_EQ(replayed.events, events);
+    for (int i = 0; i < counters.size(); i++)
+        EXPECT_TRUE(Equal(replayed.counters[i], counters[i])) << "counters differ at event " << i;
+
+    std::filesystem::remove(path);
+}
+
+TEST(Journal, ReplayWithCustomApply) {
+    auto path = TempPath("metacore-journal-apply.mcj");
+
+    Journal::SetCounters({});
+    ASSERT_TRUE(Journal::StartRecording(path));
+    for (int i = 1; i <= 5; i++) {
+        Internals::rightScore = i;
+        Events::Broadcast(Events::ScoreChanged);
+    }
+    Journal::StopRecording();
+
+    // the live statistics should be left alone when a different apply function is used
+    Internals::rightScore = -1;
+    std::vector<int> scores;
+    int broadcasts = Journal::Replay(path, 0, [&scores](Journal::Counters const& counters) { scores.emplace_back(counters.rightScore); });
+
+    EXPECT_EQ(broadcasts, 5);
+    EXPECT_EQ(scores, (std::vector<int>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(Internals::rightScore, -1);
+
+    std::filesystem::remove(path);
+}
+
+TEST(Journal, ReplaysPayloads) {
+    auto path = TempPath("metacore-journal-payload.mcj");
+    int custom = Events::RegisterEvent("journal-test", 4);
+    ASSERT_GT(custom, Events::EventMax);
+
+    struct Data {
+        int index;
+        float value;
+        char name[12];
+    };
+    std::vector<Data> sent;
+    std::vector<Data> received;
+    int id = Events::AddPayloadCallback(custom, [&received](void const* data) { received.emplace_back(*(Data const*) data); });
+
+    ASSERT_TRUE(Journal::StartRecording(path));
+    for (int i = 0; i < 20; i++) {
+        Data data = {i, i * 1.5f, {}};
+        std::snprintf(data.name, sizeof(data.name), "payload %d", i);
+        sent.emplace_back(data);
+        Events::Broadcast(custom, &data, sizeof(Data));
+        // events without data stay without data
+        Events::Broadcast(custom);
+    }
+    Journal::StopRecording();
+    received.clear();
+
+    int broadcasts = Journal::Replay(path, 0, nullptr);
+    Events::RemoveCallback(id);
+
+    EXPECT_EQ(broadcasts, 40);
+    ASSERT_EQ(received.size(), sent.size());
+    for (int i = 0; i < sent.size(); i++)
+        EXPECT_EQ(std::memcmp(&received[i], &sent[i], sizeof(Data)), 0) << "payload differs at " << i;
+
+    std::filesystem::remove(path);
+}
+
+TEST(Journal, RejectsInvalidFiles) {
+    auto path = TempPath("metacore-journal-invalid.mcj");
+
+    EXPECT_EQ(Journal::Replay(TempPath("metacore-journal-missing.mcj")), -1);
+
+    std::ofstream(path, std::ios::binary) << "not a journal";
+    EXPECT_EQ(Journal::Replay(path), -1);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "livepp.hpp"
+
+using namespace MetaCore;
+
+static LivePP::Ratings Ranked() {
+    return {
+        .hasBL = true,
+        .hasSS = true,
+        .bl = {6.f, 9.f, 3.f},
+        // a no fail modifier of -0.5
+        .blFailed = {3.f, 4.5f, 1.5f},
+        .stars = 8,
+    };
+}
+
+static LivePP::Inputs Playing(int score, float modifierMultiplier = 1) {
+    return {.score = score, .maxScore = 100000, .modifierMultiplier = modifierMultiplier, .failed = false, .noFail = false};
+}
+
+TEST(LivePP, UnrankedGivesNothing) {
+    auto [bl, ss] = LivePP::Calculate({}, Playing(95000));
+    EXPECT_EQ(bl, 0);
+    EXPECT_EQ(ss, 0);
+}
+
+TEST(LivePP, MatchesCalculations) {
+    auto [bl, ss] = LivePP::Calculate(Ranked(), Playing(95000, 1.06f));
+    EXPECT_GT(bl, 0);
+    EXPECT_EQ(bl, PP::CalculateBL(0.95f, 6, 9, 3));
+    // scoresaber applies the modifiers to the score
+    EXPECT_EQ(ss, PP::CalculateSS(0.95f * 1.06f, 8, false));
+}
+
+TEST(LivePP, EmptyMaxScoreIsFullAccuracy) {
+    auto inputs = Playing(0);
+    inputs.maxScore = 0;
+    auto [bl, ss] = LivePP::Calculate(Ranked(), inputs);
+    EXPECT_EQ(bl, PP::CalculateBL(1, 6, 9, 3));
+    EXPECT_EQ(ss, PP::CalculateSS(1, 8, false));
+}
+
+TEST(LivePP, NoFailFailAppliesPenaltyOnce) {
+    // the modifier multiplier already has the no fail penalty applied after failing
+    auto inputs = Playing(95000, 0.5f);
+    inputs.failed = true;
+    inputs.noFail = true;
+    auto [bl, ss] = LivePP::Calculate(Ranked(), inputs);
+
+    // beatleader uses the ratings with the no fail modifier instead of giving nothing
+    EXPECT_GT(bl, 0);
+    EXPECT_EQ(bl, PP::CalculateBL(0.95f, 3, 4.5f, 1.5f));
+    EXPECT_LT(bl, PP::CalculateBL(0.95f, 6, 9, 3));
+    // scoresaber halves the score once, the same as the failed calculation without modifiers
+    EXPECT_GT(ss, 0);
+    EXPECT_FLOAT_EQ(ss, PP::CalculateSS(0.95f, 8, true));
+    EXPECT_GT(ss, PP::CalculateSS(0.95f * 0.5f, 8, true));
+}
+
+TEST(LivePP, FailWithoutNoFailGivesNothing) {
+    auto inputs = Playing(95000);
+    inputs.failed = true;
+    auto [bl, ss] = LivePP::Calculate(Ranked(), inputs);
+    EXPECT_EQ(bl, 0);
+    EXPECT_EQ(ss, 0);
+}
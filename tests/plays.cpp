@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "plays.hpp"
+
+using namespace MetaCore;
+
+static std::string TempDirectory(char const* name) {
+    auto ret = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(ret);
+    return ret.string();
+}
+
+static Plays::Play MakePlay(int64_t timestamp, float accuracy, bool quit = false, bool failed = false) {
+    return {.timestamp = timestamp, .accuracy = accuracy, .quit = quit, .failed = failed};
+}
+
+TEST(Plays, UnfinishedPlaysAreFilteredByDefault) {
+    auto directory = TempDirectory("metacore-test-plays-filter");
+    ASSERT_TRUE(Plays::Open(directory));
+
+    Plays::Add("map", MakePlay(100, 0.80));
+    // a quit early on can have a much higher accuracy than a full play
+    Plays::Add("map", MakePlay(200, 0.99, true));
+    Plays::Add("other", MakePlay(300, 0.50, false, true));
+    Plays::Add("map", MakePlay(400, 0.85));
+
+    EXPECT_FLOAT_EQ(Plays::GetAverageAccuracy(0), (0.80 + 0.85) / 2);
+    EXPECT_FLOAT_EQ(Plays::GetAverageAccuracy(0, false), (0.80 + 0.99 + 0.50 + 0.85) / 4);
+    EXPECT_FLOAT_EQ(Plays::GetAverageAccuracy(150), 0.85);
+    EXPECT_FLOAT_EQ(Plays::GetAverageAccuracy("map", 0), (0.80 + 0.85) / 2);
+    EXPECT_FLOAT_EQ(Plays::GetAverageAccuracy("map", 0, false), (0.80 + 0.99 + 0.85) / 3);
+    EXPECT_EQ(Plays::GetAverageAccuracy("other", 0), 0);
+
+    auto trend = Plays::GetBestAccuracyTrend("map");
+    ASSERT_EQ(trend.size(), 2);
+    EXPECT_EQ(trend[0].timestamp, 100);
+    EXPECT_EQ(trend[1].timestamp, 400);
+    auto allTrend = Plays::GetBestAccuracyTrend("map", false);
+    ASSERT_EQ(allTrend.size(), 2);
+    EXPECT_EQ(allTrend[1].timestamp, 200);
+
+    Plays::Close();
+    std::filesystem::remove_all(directory);
+}
+
+TEST(Plays, HistoryIsReloaded) {
+    auto directory = TempDirectory("metacore-test-plays-reload");
+    ASSERT_TRUE(Plays::Open(directory));
+    for (int i = 0; i < 50; i++)
+        Plays::Add(i % 2 ? "odd" : "even", MakePlay(i, i / 100.f, i % 5 == 0));
+    auto before = std::vector<Plays::Play>(Plays::GetPlays().begin(), Plays::GetPlays().end());
+    float average = Plays::GetAverageAccuracy("odd", 10);
+    Plays::Close();
+
+    ASSERT_TRUE(Plays::Open(directory));
+    auto after = Plays::GetPlays();
+    ASSERT_EQ(after.size(), before.size());
+    for (int i = 0; i < before.size(); i++) {
+        EXPECT_EQ(after[i].timestamp, before[i].timestamp);
+        EXPECT_EQ(after[i].beatmap, before[i].beatmap);
+        EXPECT_EQ(after[i].quit, before[i].quit);
+    }
+    EXPECT_EQ(Plays::GetBeatmap(after[1].beatmap), "odd");
+    EXPECT_EQ(Plays::GetAverageAccuracy("odd", 10), average);
+
+    Plays::Close();
+    std::filesystem::remove_all(directory);
+}
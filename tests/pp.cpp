@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cstring>
+#include <vector>
+
+#include "ppmath.hpp"
+
+using namespace MetaCore;
+
+// every float accuracy from 0.5 to 1, where the curves have the most points, plus a sweep of the rest and past the ends
+static std::vector<float> const& Accuracies() {
+    static std::vector<float> ret = []() {
+        std::vector<float> ret;
+        for (uint32_t bits = std::bit_cast<uint32_t>(0.5f); bits <= std::bit_cast<uint32_t>(1.0f); bits++)
+            ret.emplace_back(std::bit_cast<float>(bits));
+        for (int i = 0; i <= 100000; i++)
+            ret.emplace_back(i / 200000.0f);
+        ret.insert(ret.end(), {-1.0f, -0.0f, 1.5f, 2.0f});
+        return ret;
+    }();
+    return ret;
+}
+
+// compared by bits so that the results are exactly the same, not just close
+static void ExpectIdentical(std::vector<float> const& batch, std::vector<float> const& single) {
+    ASSERT_EQ(batch.size(), single.size());
+    int mismatches = 0;
+    for (int i = 0; i < batch.size(); i++) {
+        if (std::bit_cast<uint32_t>(batch[i]) != std::bit_cast<uint32_t>(single[i]) && mismatches++ < 10)
+            ADD_FAILURE() << "accuracy " << Accuracies()[i] << ": batch " << batch[i] << " single " << single[i];
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+struct RatingsBL {
+    float pass;
+    float acc;
+    float tech;
+};
+
+TEST(PP, BatchMatchesSingleBL) {
+    auto const& accuracies = Accuracies();
+    std::vector<float> batch(accuracies.size());
+    std::vector<float> single(accuracies.size());
+    for (auto [pass, acc, tech] : {RatingsBL{8.5, 10.2, 4.1}, RatingsBL{0, 3, 0.5}, RatingsBL{14.1, 12.7, 9.3}}) {
+        PP::CalculateBL(accuracies, batch, pass, acc, tech);
+        for (int i = 0; i < accuracies.size(); i++)
+            single[i] = PP::CalculateBL(accuracies[i], pass, acc, tech);
+        ExpectIdentical(batch, single);
+    }
+}
+
+TEST(PP, BatchMatchesSingleSS) {
+    auto const& accuracies = Accuracies();
+    std::vector<float> batch(accuracies.size());
+    std::vector<float> single(accuracies.size());
+    for (float stars : {0.5f, 9.7f, 13.2f}) {
+        for (bool failed : {false, true}) {
+            PP::CalculateSS(accuracies, batch, stars, failed);
+            for (int i = 0; i < accuracies.size(); i++)
+                single[i] = PP::CalculateSS(accuracies[i], stars, failed);
+            ExpectIdentical(batch, single);
+        }
+    }
+}
+
+TEST(PP, BatchStopsAtShorterSpan) {
+    std::vector<float> accuracies = {0.9, 0.95, 0.99};
+    std::vector<float> results = {-1, -1};
+    PP::CalculateSS(accuracies, results, 9.7, false);
+    EXPECT_EQ(results[1], PP::CalculateSS(0.95, 9.7, false));
+
+    results = {-1, -1, -1, -1};
+    PP::CalculateBL(std::span(accuracies).first(2), results, 8.5, 10.2, 4.1);
+    EXPECT_EQ(results[1], PP::CalculateBL(0.95, 8.5, 10.2, 4.1));
+    EXPECT_EQ(results[2], -1);
+}
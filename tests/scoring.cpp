@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "scoring.hpp"
+
+using namespace MetaCore;
+
+// the max score of a map with only normal notes, from ScoreModel::MaxScoreForNumberOfNotes
+static int MaxScoreForNotes(int notes) {
+    if (notes >= 14)
+        return 115 * (8 * notes - 63);
+    // 1 note at x1, 4 at x2, 8 at x4
+    int score = 0;
+    for (int i = 0; i < notes; i++)
+        score += 115 * (i < 1 ? 1 : i < 5 ? 2 : 4);
+    return score;
+}
+
+static std::vector<int> Compute(std::vector<Scoring::Element> elements, std::vector<float>* times = nullptr) {
+    std::vector<float> outTimes;
+    std::vector<int> totals;
+    Scoring::ComputeMaxScores(elements, outTimes, totals);
+    EXPECT_EQ(outTimes.size(), totals.size());
+    if (times)
+        *times = outTimes;
+    return totals;
+}
+
+TEST(Scoring, MatchesGameForNormalNotes) {
+    for (int notes : {1, 2, 5, 6, 13, 14, 100, 2000}) {
+        std::vector<Scoring::Element> elements;
+        for (int i = 0; i < notes; i++)
+            elements.emplace_back(Scoring::Element{i * 0.25f, 115});
+        auto totals = Compute(elements);
+        ASSERT_EQ(totals.size(), notes);
+        EXPECT_EQ(totals.back(), MaxScoreForNotes(notes)) << notes << " notes";
+        for (int i = 0; i < notes; i++)
+            EXPECT_EQ(totals[i], MaxScoreForNotes(i + 1)) << "running total at note " << i;
+    }
+    // well known totals
+    EXPECT_EQ(MaxScoreForNotes(13), 4715);
+    EXPECT_EQ(MaxScoreForNotes(100), 84755);
+}
+
+TEST(Scoring, SortsChainElementsIntoNotes) {
+    // a chain head (85) at 1s with 3 elements (20) over the next half second, and normal notes around it,
+    // with the elements added after all the notes like when scanning the beatmap
+    std::vector<Scoring::Element> elements = {
+        {0.5f, 115},
+        {1.f, 85},
+        {2.f, 115},
+        {1 + 0.5f / 3, 20},
+        {1 + 1.f / 3, 20},
+        {1.5f, 20},
+    };
+    std::vector<float> times;
+    auto totals = Compute(elements, &times);
+
+    EXPECT_EQ(times, (std::vector<float>{0.5f, 1.f, 1 + 0.5f / 3, 1 + 1.f / 3, 1.5f, 2.f}));
+    // x1, x2, x2, x2, x2, x4
+    EXPECT_EQ(totals, (std::vector<int>{115, 285, 325, 365, 405, 865}));
+}
+
+TEST(Scoring, KeepsOrderOfSimultaneousElements) {
+    std::vector<float> times;
+    auto totals = Compute({{1.f, 115}, {1.f, 20}, {0.5f, 85}}, &times);
+
+    EXPECT_EQ(times, (std::vector<float>{0.5f, 1.f, 1.f}));
+    EXPECT_EQ(totals, (std::vector<int>{85, 85 + 230, 85 + 230 + 40}));
+}
+
+TEST(Scoring, EmptyMap) {
+    EXPECT_TRUE(Compute({}).empty());
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "session.hpp"
+
+using namespace MetaCore;
+
+static std::string TempPath(char const* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static SessionLog::Record MakeRecord(int i) {
+    return {
+        .songTime = i * 0.01f,
+        .type = (SessionLog::RecordType) (i % 10),
+        .saber = (int8_t) (i % 3),
+        .beforeCutScore = (uint8_t) (i % 71),
+        .afterCutScore = (uint8_t) (i % 31),
+        .centerCutScore = (uint8_t) (i % 16),
+        .multiplier = (uint8_t) (1 << (i % 4)),
+        .reserved = 0,
+        .combo = i,
+        .score = i * 115,
+        .health = (i % 100) / 100.f,
+        .cutDistance = (i % 7) * 0.05f,
+        .timeDeviation = (i % 5) * -0.01f,
+    };
+}
+
+static bool Equal(SessionLog::Record const& a, SessionLog::Record const& b) {
+    return std::memcmp(&a, &b, sizeof(SessionLog::Record)) == 0;
+}
+
+// logs records 0 to count - 1 and finishes, without waiting for the writer thread
+static void WriteLog(std::string const& path, std::string const& beatmap, int count) {
+    ASSERT_TRUE(SessionLog::Begin(path, beatmap));
+    EXPECT_TRUE(SessionLog::IsLogging());
+    for (int i = 0; i < count; i++)
+        SessionLog::Log(MakeRecord(i));
+    SessionLog::Finish();
+    EXPECT_FALSE(SessionLog::IsLogging());
+}
+
+TEST(SessionLog, RoundTrip) {
+    auto first = TempPath("metacore-sessionlog-first.mcs");
+    auto second = TempPath("metacore-sessionlog-second.mcs");
+    // several full blocks so both buffers are handed to the writer, and a partial one left for Finish
+    int count = 5000;
+
+    WriteLog(first, "first beatmap", count);
+    // starting the next log right away has to wait for the previous one to be finished by the writer
+    WriteLog(second, "second beatmap", 10);
+    SessionLog::Join();
+
+    std::string beatmap;
+    auto records = SessionLog::Read(first, 0, std::numeric_limits<float>::infinity(), &beatmap);
+    EXPECT_EQ(beatmap, "first beatmap");
+    ASSERT_EQ(records.size(), count);
+    for (int i = 0; i < count; i++)
+        EXPECT_TRUE(Equal(records[i], MakeRecord(i))) << "record " << i << " differs";
+
+    records = SessionLog::Read(second, 0, std::numeric_limits<float>::infinity(), &beatmap);
+    EXPECT_EQ(beatmap, "second beatmap");
+    EXPECT_EQ(records.size(), 10);
+
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+}
+
+TEST(SessionLog, IndexSkipsBlocks) {
+    auto path = TempPath("metacore-sessionlog-index.mcs");
+    int count = 4096;
+    WriteLog(path, "index", count);
+    SessionLog::Join();
+
+    auto records = SessionLog::Read(path, 15, 25);
+    ASSERT_FALSE(records.empty());
+    for (auto const& record : records) {
+        EXPECT_GE(record.songTime, 15);
+        EXPECT_LE(record.songTime, 25);
+    }
+    EXPECT_EQ(records.front().combo, 1500);
+    EXPECT_EQ(records.back().combo, 2500);
+
+    // overwrite the first block with records inside the range, which are only found if it isn't skipped using the index
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        auto fake = MakeRecord(2000);
+        file.seekp(4 + 4 + 4 + 2 + 5);
+        file.write((char const*) &fake, sizeof(fake));
+    }
+    EXPECT_EQ(SessionLog::Read(path, 15, 25).size(), records.size());
+    // but still found when the range includes the first block
+    EXPECT_EQ(SessionLog::Read(path, 0, 25).size(), 2501);
+
+    std::filesystem::remove(path);
+}
+
+TEST(SessionLog, RecoversUnfinishedLog) {
+    auto path = TempPath("metacore-sessionlog-unfinished.mcs");
+    int count = 3000;
+    WriteLog(path, "unfinished", count);
+    SessionLog::Join();
+
+    // as if the game closed after writing some blocks, before the index and trailer, and partway through a record
+    int written = 2048;
+    auto headerSize = 4 + 4 + 4 + 2 + 10;
+    std::filesystem::resize_file(path, headerSize + written * sizeof(SessionLog::Record) + 7);
+
+    std::string beatmap;
+    auto records = SessionLog::Read(path, 0, std::numeric_limits<float>::infinity(), &beatmap);
+    EXPECT_EQ(beatmap, "unfinished");
+    ASSERT_EQ(records.size(), written);
+    for (int i = 0; i < written; i++)
+        EXPECT_TRUE(Equal(records[i], MakeRecord(i))) << "record " << i << " differs";
+    EXPECT_EQ(SessionLog::Read(path, 10, 15).size(), 501);
+
+    std::filesystem::remove(path);
+}
+
+TEST(SessionLog, RejectsInvalidFiles) {
+    auto path = TempPath("metacore-sessionlog-invalid.mcs");
+
+    EXPECT_TRUE(SessionLog::Read(TempPath("metacore-sessionlog-missing.mcs")).empty());
+
+    std::ofstream(path, std::ios::binary) << "not a session log";
+    EXPECT_TRUE(SessionLog::Read(path).empty());
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "publish.hpp"
+#include "sharedstats.hpp"
+
+using namespace MetaCore;
+
+static constexpr int Words = sizeof(Stats::Snapshot) / sizeof(uint32_t);
+
+static std::string TempPath(char const* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// every word of the snapshot set to the same value, so a torn read shows up as a mix
+static Stats::Snapshot MakeSnapshot(uint32_t value) {
+    std::array<uint32_t, Words> words;
+    words.fill(value);
+    Stats::Snapshot ret;
+    std::memcpy(&ret, words.data(), sizeof(ret));
+    return ret;
+}
+
+// the shared value of the words, or -1 if they differ
+static int64_t SnapshotValue(Stats::Snapshot const& snapshot) {
+    std::array<uint32_t, Words> words;
+    std::memcpy(words.data(), &snapshot, sizeof(snapshot));
+    for (auto word : words) {
+        if (word != words[0])
+            return -1;
+    }
+    return words[0];
+}
+
+TEST(SharedStats, RoundTrip) {
+    auto path = TempPath("metacore-sharedstats-roundtrip.mcss");
+    ASSERT_TRUE(SharedStats::Enable(path));
+    EXPECT_TRUE(SharedStats::IsEnabled());
+
+    auto layout = SharedStats::Open(path);
+    ASSERT_NE(layout, nullptr);
+    EXPECT_EQ(layout->magic, SharedStats::Magic);
+    EXPECT_EQ(layout->version, SharedStats::Version);
+    EXPECT_EQ(layout->size, sizeof(SharedStats::Layout));
+    EXPECT_EQ(layout->snapshot.Count(), 0);
+
+    auto snapshot = MakeSnapshot(0);
+    snapshot.sequence = 41;
+    snapshot.valid = 1;
+    snapshot.songTime = 12.5;
+    snapshot.score[2] = 123456;
+    snapshot.combo[0] = 99;
+    snapshot.averageSpeed[1] = 3.25;
+    SharedStats::Publish(snapshot);
+
+    auto read = layout->snapshot.Read();
+    EXPECT_EQ(layout->snapshot.Count(), 1);
+    EXPECT_EQ(std::memcmp(&read, &snapshot, sizeof(snapshot)), 0);
+
+    // the last snapshot stays readable after the writer stops
+    SharedStats::Disable();
+    EXPECT_FALSE(SharedStats::IsEnabled());
+    read = layout->snapshot.Read();
+    EXPECT_EQ(read.score[2], 123456);
+
+    SharedStats::Close(layout);
+    std::filesystem::remove(path);
+}
+
+TEST(SharedStats, ReaderProcessSeesOnlyWholeSnapshots) {
+    auto path = TempPath("metacore-sharedstats-process.mcss");
+    constexpr uint32_t Writes = 200000;
+    ASSERT_TRUE(SharedStats::Enable(path));
+
+    // a separate process maps the file on its own, like an overlay would
+    pid_t reader = fork();
+    ASSERT_GE(reader, 0);
+    if (reader == 0) {
+        auto layout = SharedStats::Open(path);
+        if (!layout)
+            _exit(2);
+        int64_t last = 0;
+        while (last < Writes) {
+            int64_t value = SnapshotValue(layout->snapshot.Read());
+            // torn, or older than a snapshot that was already read
+            if (value < last)
+                _exit(1);
+            last = value;
+        }
+        _exit(0);
+    }
+
+    for (uint32_t i = 1; i <= Writes; i++)
+        SharedStats::Publish(MakeSnapshot(i));
+
+    int status;
+    ASSERT_EQ(waitpid(reader, &status, 0), reader);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0) << "1 means a torn or out of order read, 2 that the file could not be opened";
+
+    SharedStats::Disable();
+    std::filesystem::remove(path);
+}
+
+TEST(SharedStats, RejectsInvalidFiles) {
+    auto path = TempPath("metacore-sharedstats-invalid.mcss");
+
+    EXPECT_EQ(SharedStats::Open(TempPath("metacore-sharedstats-missing.mcss")), nullptr);
+
+    // too short to contain a layout
+    std::ofstream(path, std::ios::binary) << "MCSS";
+    EXPECT_EQ(SharedStats::Open(path), nullptr);
+
+    // the right size, but the wrong version
+    ASSERT_TRUE(SharedStats::Enable(path));
+    SharedStats::Disable();
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        uint32_t version = SharedStats::Version + 1;
+        file.seekp(offsetof(SharedStats::Layout, version));
+        file.write((char const*) &version, sizeof(version));
+    }
+    EXPECT_EQ(SharedStats::Open(path), nullptr);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <span>
+#include <vector>
+
+#include "cuts.hpp"
+#include "timeline.hpp"
+
+using namespace MetaCore;
+
+template <class T>
+static std::vector<T> ToVector(std::span<T const> span) {
+    return {span.begin(), span.end()};
+}
+
+static void RecordCut(int i) {
+    Timeline::Record(Timeline::GoodCut, i * 0.5f, i % 2, 70, 30, 15, 0.1f * i, 0.01f * i, 90 + i, 1 << (i % 4));
+}
+
+TEST(Timeline, ResetClearsPreviousMap) {
+    Timeline::Reset(8);
+    for (int i = 0; i < 5; i++)
+        RecordCut(i);
+    EXPECT_EQ(Timeline::GetNoteCount(), 5);
+
+    Timeline::Reset(8);
+    EXPECT_EQ(Timeline::GetNoteCount(), 0);
+    EXPECT_TRUE(Timeline::GetTimes().empty());
+    EXPECT_TRUE(Timeline::GetKinds().empty());
+}
+
+TEST(Timeline, GrowsPastReservedNotes) {
+    Timeline::Reset(4);
+    // more than one doubling past the reservation
+    int count = 200;
+    for (int i = 0; i < count; i++)
+        RecordCut(i);
+
+    ASSERT_EQ(Timeline::GetNoteCount(), count);
+    auto times = Timeline::GetTimes();
+    auto sabers = Timeline::GetSabers();
+    auto angles = Timeline::GetCutAngles();
+    auto multipliers = Timeline::GetMultipliers();
+    ASSERT_EQ(times.size(), count);
+    ASSERT_EQ(multipliers.size(), count);
+    // values from before the growth are kept in every column
+    for (int i = 0; i < count; i++) {
+        EXPECT_FLOAT_EQ(times[i], i * 0.5f);
+        EXPECT_EQ(sabers[i], i % 2);
+        EXPECT_FLOAT_EQ(angles[i], 90 + i);
+        EXPECT_EQ(multipliers[i], 1 << (i % 4));
+    }
+}
+
+TEST(Timeline, SpansMatchRecordedNotes) {
+    Timeline::Reset(16);
+    Timeline::Record(Timeline::GoodCut, 1.5f, 0, 70, 28, 14, 0.05f, -0.02f, 95, 2);
+    Timeline::RecordMiss(Timeline::BadCut, 1.75f, 1, 0.3f, 0.04f, 40, 1);
+    Timeline::RecordMiss(Timeline::Miss, 2.f, 0, 0, 0, 0, 1);
+
+    ASSERT_EQ(Timeline::GetNoteCount(), 3);
+    EXPECT_EQ(ToVector(Timeline::GetKinds()), (std::vector<int>{Timeline::GoodCut, Timeline::BadCut, Timeline::Miss}));
+    EXPECT_EQ(ToVector(Timeline::GetTimes()), (std::vector<float>{1.5f, 1.75f, 2.f}));
+    EXPECT_EQ(ToVector(Timeline::GetSabers()), (std::vector<int>{0, 1, 0}));
+    EXPECT_EQ(ToVector(Timeline::GetBeforeCutScores()), (std::vector<int>{70, 0, 0}));
+    EXPECT_EQ(ToVector(Timeline::GetAfterCutScores()), (std::vector<int>{28, 0, 0}));
+    EXPECT_EQ(ToVector(Timeline::GetCenterCutScores()), (std::vector<int>{14, 0, 0}));
+    EXPECT_EQ(ToVector(Timeline::GetCutDistances()), (std::vector<float>{0.05f, 0.3f, 0}));
+    EXPECT_EQ(ToVector(Timeline::GetTimeDeviations()), (std::vector<float>{-0.02f, 0.04f, 0}));
+    EXPECT_EQ(ToVector(Timeline::GetCutAngles()), (std::vector<float>{95, 40, 0}));
+    EXPECT_EQ(ToVector(Timeline::GetMultipliers()), (std::vector<int>{2, 1, 1}));
+}
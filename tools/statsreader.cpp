@@ -0,0 +1,52 @@
+// reference reader for the file written by MetaCore::SharedStats::Enable
+// usage: metacore-stats-reader <path> [interval ms]
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "sharedstats.hpp"
+
+using namespace MetaCore;
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fmt::print(stderr, "usage: {} <path> [interval ms]\n", argv[0]);
+        return 1;
+    }
+    int interval = argc > 2 ? std::stoi(argv[2]) : 100;
+
+    auto layout = SharedStats::Open(argv[1]);
+    if (!layout) {
+        fmt::print(stderr, "could not open {} as shared stats version {}\n", argv[1], SharedStats::Version);
+        return 1;
+    }
+
+    int last = -1;
+    while (true) {
+        // a plain memory read, no syscalls
+        auto snapshot = layout->snapshot.Read();
+        if (snapshot.sequence != last) {
+            last = snapshot.sequence;
+            float accuracy = snapshot.maxScore[2] > 0 ? snapshot.score[2] * 100.0 / snapshot.maxScore[2] : 100;
+            fmt::print(
+                "#{} {} {:.1f}s score {} ({:.2f}%) combo {} health {:.2f} notes {}/{} missed {}\n",
+                snapshot.sequence,
+                snapshot.valid ? "playing" : "idle",
+                snapshot.songTime,
+                snapshot.score[2],
+                accuracy,
+                snapshot.combo[2],
+                snapshot.health,
+                snapshot.notesCut[2],
+                snapshot.songNotes,
+                snapshot.notesMissed[2]
+            );
+            std::fflush(stdout);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+    }
+}